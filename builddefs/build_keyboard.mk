@@ -18,8 +18,14 @@ QMK_BIN ?= qmk
 
 # Set the filename for the final firmware binary
 KEYBOARD_FILESAFE := $(subst /,_,$(KEYBOARD))
-TARGET ?= $(KEYBOARD_FILESAFE)_$(KEYMAP)
-KEYBOARD_OUTPUT := $(BUILD_DIR)/obj_$(KEYBOARD_FILESAFE)
+ifeq ($(strip $(SIMULATE)), yes)
+    # Host builds keep their objects and generated files apart from the firmware's
+    TARGET ?= $(KEYBOARD_FILESAFE)_$(KEYMAP)_simulate
+    KEYBOARD_OUTPUT := $(BUILD_DIR)/obj_$(KEYBOARD_FILESAFE)_simulate
+else
+    TARGET ?= $(KEYBOARD_FILESAFE)_$(KEYMAP)
+    KEYBOARD_OUTPUT := $(BUILD_DIR)/obj_$(KEYBOARD_FILESAFE)
+endif
 
 # Force expansion
 TARGET := $(TARGET)
@@ -110,6 +116,13 @@ MAIN_KEYMAP_PATH_5 := $(KEYBOARD_PATH_5)/keymaps/$(KEYMAP)
 INFO_RULES_MK = $(shell $(QMK_BIN) generate-rules-mk --quiet --escape --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/info_rules.mk)
 include $(INFO_RULES_MK)
 
+# Sources added by the keyboard drive its hardware, which simulator builds leave out
+ifeq ($(strip $(SIMULATE)), yes)
+    SRC =
+    LIB_SRC =
+    QUANTUM_LIB_SRC =
+endif
+
 # Check for keymap.json first, so we can regenerate keymap.c
 include $(BUILDDEFS_PATH)/build_json.mk
 
@@ -160,7 +173,7 @@ ifneq ("$(wildcard $(KEYMAP_JSON))", "")
 # Add rules to generate the keymap files - indentation here is important
 $(KEYMAP_OUTPUT)/src/keymap.c: $(KEYMAP_JSON)
 	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) json2c --quiet --output $(KEYMAP_C) $(KEYMAP_JSON))
+	$(eval CMD=$(QMK_BIN) json2c --quiet $(if $(filter yes,$(strip $(SPARSE_KEYMAP_ENABLE))),--sparse) --output $(KEYMAP_C) $(KEYMAP_JSON))
 	@$(BUILD_CMD)
 
 $(KEYMAP_OUTPUT)/src/config.h: $(KEYMAP_JSON)
@@ -170,6 +183,8 @@ $(KEYMAP_OUTPUT)/src/config.h: $(KEYMAP_JSON)
 
 generated-files: $(KEYMAP_OUTPUT)/src/config.h $(KEYMAP_OUTPUT)/src/keymap.c
 
+else ifeq ($(strip $(SPARSE_KEYMAP_ENABLE)), yes)
+    $(call CATASTROPHIC_ERROR,Invalid SPARSE_KEYMAP_ENABLE,SPARSE_KEYMAP_ENABLE needs a keymap.json to generate the sparse keymap from)
 endif
 
 ifeq ($(strip $(CTPC)), yes)
@@ -383,6 +398,11 @@ ifneq ("$(wildcard $(KEYBOARD_PATH_5)/post_rules.mk)","")
     include $(KEYBOARD_PATH_5)/post_rules.mk
 endif
 
+# Swap the keyboard's MCU for the host side simulator
+ifeq ($(strip $(SIMULATE)), yes)
+    include $(BUILDDEFS_PATH)/simulate.mk
+endif
+
 ifneq ("$(wildcard $(KEYMAP_PATH)/config.h)","")
     CONFIG_H += $(KEYMAP_PATH)/config.h
 endif
@@ -457,7 +477,9 @@ $(KEYBOARD_OUTPUT)_INC := $(PROJECT_INC)
 $(KEYBOARD_OUTPUT)_CONFIG := $(PROJECT_CONFIG)
 
 # Default target.
-ifeq ($(SKIP_COMPILE),no)
+ifeq ($(strip $(SIMULATE)), yes)
+all: elf
+else ifeq ($(SKIP_COMPILE),no)
 all: build check-size
 else
 all:
@@ -117,6 +117,7 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         MOUSE_ENABLE := yes
         SRC += $(QUANTUM_DIR)/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device_drivers.c
+        SRC += $(QUANTUM_DIR)/pointing_device_transform.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -551,6 +552,13 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     OPT_DEFS += -DVIA_ENABLE
 endif
 
+ifeq ($(strip $(TELEMETRY_ENABLE)), yes)
+    RAW_ENABLE := yes
+    OPT_DEFS += -DTELEMETRY_ENABLE
+    COMMON_VPATH += $(QUANTUM_DIR)/telemetry
+    SRC += $(QUANTUM_DIR)/telemetry/telemetry.c
+endif
+
 VALID_MAGIC_TYPES := yes
 BOOTMAGIC_ENABLE ?= no
 ifneq ($(strip $(BOOTMAGIC_ENABLE)), no)
@@ -270,6 +270,13 @@ $(foreach LOBJ, $(NO_LTO_OBJ), $(eval $(call NO_LTO,$(LOBJ))))
 
 MOVE_DEP = mv -f $(patsubst %.o,%.td,$@) $(patsubst %.o,%.d,$@)
 
+# Share C objects between builds with identical preprocessed sources and flags,
+# such as the quantum/ objects of most keyboards in a multibuild
+ifeq ($(strip $(OBJECT_CACHE)), yes)
+    OBJECT_CACHE_DIR ?= $(BUILD_DIR)/object_cache
+    OBJECT_CACHE_EXEC = util/cached_compile.sh $(OBJECT_CACHE_DIR)
+endif
+
 # For a ChibiOS build, ensure that the board files have the hook overrides injected
 define BOARDSRC_INJECT_HOOKS
 $(KEYBOARD_OUTPUT)/$(patsubst %.c,%.o,$(patsubst ./%,%,$1)): INIT_HOOK_CFLAGS += -include $(TOP_DIR)/tmk_core/protocol/chibios/init_hooks.h
@@ -377,7 +384,7 @@ $1_ASFLAGS = $$(ALL_ASFLAGS) $$($1_DEFS) $$($1_INCFLAGS) $$($1_CONFIG_FLAGS)
 $1/%.o : %.c $1/%.d $1/cflags.txt $1/compiler.txt | $(BEGIN)
 	@mkdir -p $$(@D)
 	@$$(SILENT) || printf "$$(MSG_COMPILING) $$<" | $$(AWK_CMD)
-	$$(eval CC_EXEC := $$(CC))
+	$$(eval CC_EXEC := $$(OBJECT_CACHE_EXEC) $$(CC))
     ifneq ($$(VERBOSE_C_CMD),)
 	$$(if $$(filter $$(notdir $$(VERBOSE_C_CMD)),$$(notdir $$<)),$$(eval CC_EXEC += -v))
     endif
@@ -32,6 +32,7 @@ GENERIC_FEATURES = \
     LEADER \
     PROGRAMMABLE_BUTTON \
     SPACE_CADET \
+    SPARSE_KEYMAP \
     SWAP_HANDS \
     TAP_DANCE \
     VELOCIKEY \
@@ -10,8 +10,10 @@ BUILD_OPTION_NAMES = \
   DEBOUNCE_TYPE \
   SPLIT_KEYBOARD \
   DYNAMIC_KEYMAP_ENABLE \
+  SPARSE_KEYMAP_ENABLE \
   USB_HID_ENABLE \
-  VIA_ENABLE
+  VIA_ENABLE \
+  TELEMETRY_ENABLE
 
 HARDWARE_OPTION_NAMES = \
   SLEEP_LED_ENABLE \
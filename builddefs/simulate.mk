@@ -0,0 +1,29 @@
+# Build settings for SIMULATE = yes, which compiles a keyboard's keymap for the
+# host instead of its MCU. The runtime lives in tmk_core/protocol/simulate.
+
+PLATFORM := TEST
+PLATFORM_KEY := test
+PROTOCOL := SIMULATE
+FIRMWARE_FORMAT :=
+override BOOTLOADER_TYPE := none
+
+# The simulator supplies the matrix, and the keyboard level code drives
+# hardware the host does not have
+CUSTOM_MATRIX := lite
+KEYBOARD_SRC :=
+EEPROM_DRIVER := vendor
+FLASH_DRIVER := no
+
+# Features that need peripherals or a USB endpoint the simulator does not provide
+SIMULATE_DISABLED_FEATURES := \
+	AUDIO BACKLIGHT BLUETOOTH CONSOLE DIGITIZER DIP_SWITCH ENCODER HAPTIC \
+	HD44780 JOYSTICK LCD LCD_BACKLIGHT LED_MATRIX MIDI OLED POINTING_DEVICE \
+	PS2 PS2_MOUSE QUANTUM_PAINTER RAW RGBLIGHT RGB_MATRIX SLEEP_LED \
+	SPLIT_KEYBOARD ST7565 VIA VIRTSER WPM_OLED
+
+$(foreach FEATURE,$(SIMULATE_DISABLED_FEATURES),$(eval $(FEATURE)_ENABLE := no))
+
+# Cuts idle gaps of the trace short, see tmk_core/protocol/simulate/simulate.c
+ifeq ($(strip $(SIMULATE_SKIP_IDLE)), yes)
+    OPT_DEFS += -DSIMULATE_SKIP_IDLE
+endif
@@ -81,8 +81,13 @@ void rn42_send_mouse(report_mouse_t *report) {
     uart_write(0x00);
     uart_write(0x03);
     uart_write(report->buttons);
+#ifdef MOUSE_EXTENDED_REPORT
+    uart_write(report->boot_x);
+    uart_write(report->boot_y);
+#else
     uart_write(report->x);
     uart_write(report->y);
+#endif
     uart_write(report->v); // should try sending the wheel v here
     uart_write(report->h); // should try sending the wheel h here
     uart_write(0x00);
@@ -19,6 +19,17 @@
 
 #include "eeprom_driver.h"
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+
+static void eeprom_telemetry(const void *addr, uint16_t len) {
+    uint16_t payload[2] = {(uintptr_t)addr, len};
+    telemetry_record(TELEMETRY_EEPROM_WRITE, payload, sizeof(payload));
+}
+#else
+#    define eeprom_telemetry(addr, len)
+#endif
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
@@ -38,14 +49,17 @@ uint32_t eeprom_read_dword(const uint32_t *addr) {
 }
 
 void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+    eeprom_telemetry(addr, 1);
     eeprom_write_block(&value, addr, 1);
 }
 
 void eeprom_write_word(uint16_t *addr, uint16_t value) {
+    eeprom_telemetry(addr, 2);
     eeprom_write_block(&value, addr, 2);
 }
 
 void eeprom_write_dword(uint32_t *addr, uint32_t value) {
+    eeprom_telemetry(addr, 4);
     eeprom_write_block(&value, addr, 4);
 }
 
@@ -53,6 +67,7 @@ void eeprom_update_block(const void *buf, void *addr, size_t len) {
     uint8_t read_buf[len];
     eeprom_read_block(read_buf, addr, len);
     if (memcmp(buf, read_buf, len) != 0) {
+        eeprom_telemetry(addr, len);
         eeprom_write_block(buf, addr, len);
     }
 }
@@ -52,6 +52,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "ps2.h"
 #include "ps2_io.h"
 #include "print.h"
+#include "ring_buffer.h"
 #include "wait.h"
 
 #define WAIT(stat, us, err)     \
@@ -64,10 +65,11 @@ POSSIBILITY OF SUCH DAMAGE.
 
 uint8_t ps2_error = PS2_ERR_NONE;
 
-static inline uint8_t pbuf_dequeue(void);
-static inline void    pbuf_enqueue(uint8_t data);
-static inline bool    pbuf_has_data(void);
-static inline void    pbuf_clear(void);
+/*--------------------------------------------------------------------
+ * Ring buffer to store scan codes from keyboard
+ *------------------------------------------------------------------*/
+#define PBUF_SIZE 32
+RING_BUFFER_DECLARE(pbuf, uint8_t, PBUF_SIZE);
 
 #if defined(PROTOCOL_CHIBIOS)
 void ps2_interrupt_service_routine(void);
@@ -161,14 +163,17 @@ uint8_t ps2_host_recv_response(void) {
     while (retry-- && !pbuf_has_data()) {
         wait_ms(1);
     }
-    return pbuf_dequeue();
+    uint8_t data = 0;
+    pbuf_dequeue(&data);
+    return data;
 }
 
 /* get data received by interrupt */
 uint8_t ps2_host_recv(void) {
-    if (pbuf_has_data()) {
+    uint8_t data = 0;
+    if (pbuf_dequeue(&data)) {
         ps2_error = PS2_ERR_NONE;
-        return pbuf_dequeue();
+        return data;
     } else {
         ps2_error = PS2_ERR_NODATA;
         return 0;
@@ -228,7 +233,9 @@ void ps2_interrupt_service_routine(void) {
             break;
         case STOP:
             if (!data_in()) goto ERROR;
-            pbuf_enqueue(data);
+            if (!pbuf_enqueue(data)) {
+                print("pbuf: full\n");
+            }
             goto DONE;
             break;
         default:
@@ -256,89 +263,3 @@ void ps2_host_set_led(uint8_t led) {
     ps2_host_send(0xED);
     ps2_host_send(led);
 }
-
-/*--------------------------------------------------------------------
- * Ring buffer to store scan codes from keyboard
- *------------------------------------------------------------------*/
-#define PBUF_SIZE 32
-static uint8_t     pbuf[PBUF_SIZE];
-static uint8_t     pbuf_head = 0;
-static uint8_t     pbuf_tail = 0;
-static inline void pbuf_enqueue(uint8_t data) {
-#if defined(__AVR__)
-    uint8_t sreg = SREG;
-    cli();
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysLockFromISR();
-#endif
-
-    uint8_t next = (pbuf_head + 1) % PBUF_SIZE;
-    if (next != pbuf_tail) {
-        pbuf[pbuf_head] = data;
-        pbuf_head       = next;
-    } else {
-        print("pbuf: full\n");
-    }
-
-#if defined(__AVR__)
-    SREG = sreg;
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysUnlockFromISR();
-#endif
-}
-static inline uint8_t pbuf_dequeue(void) {
-    uint8_t val = 0;
-
-#if defined(__AVR__)
-    uint8_t sreg = SREG;
-    cli();
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysLock();
-#endif
-
-    if (pbuf_head != pbuf_tail) {
-        val       = pbuf[pbuf_tail];
-        pbuf_tail = (pbuf_tail + 1) % PBUF_SIZE;
-    }
-
-#if defined(__AVR__)
-    SREG = sreg;
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysUnlock();
-#endif
-
-    return val;
-}
-static inline bool pbuf_has_data(void) {
-#if defined(__AVR__)
-    uint8_t sreg = SREG;
-    cli();
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysLock();
-#endif
-
-    bool has_data = (pbuf_head != pbuf_tail);
-
-#if defined(__AVR__)
-    SREG = sreg;
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysUnlock();
-#endif
-    return has_data;
-}
-static inline void pbuf_clear(void) {
-#if defined(__AVR__)
-    uint8_t sreg = SREG;
-    cli();
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysLock();
-#endif
-
-    pbuf_head = pbuf_tail = 0;
-
-#if defined(__AVR__)
-    SREG = sreg;
-#elif defined(PROTOCOL_CHIBIOS)
-    chSysUnlock();
-#endif
-}
@@ -258,13 +258,16 @@ report_pmw3389_t pmw3389_read_burst(void) {
     spi_write(REG_Motion_Burst);
     wait_us(35); // waits for tSRAD_MOTBR
 
-    report.motion = spi_read();
-    spi_read(); // skip Observation
+    // Motion, Observation and the delta registers, read as a single transfer
+    uint8_t burst[6];
+    spi_receive(burst, sizeof(burst));
+
+    report.motion = burst[0];
     // delta registers
-    report.dx  = spi_read();
-    report.mdx = spi_read();
-    report.dy  = spi_read();
-    report.mdy = spi_read();
+    report.dx  = burst[2];
+    report.mdx = burst[3];
+    report.dy  = burst[4];
+    report.mdy = burst[5];
 
     if (report.motion & 0b111) { // panic recovery, sometimes burst mode works weird.
         _inBurst = false;
@@ -0,0 +1,18 @@
+#include QMK_KEYBOARD_H
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    LAYOUT_ortho_1x1(KC_A)
+};
+
+static uint32_t tap_b(uint32_t trigger_time, void *cb_arg) {
+    tap_code(KC_B);
+    return 0;
+}
+
+// Taps B long after A was released, for the idle gaps of lib/python/qmk/tests/simulate_trace.txt
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        defer_exec(3000, tap_b, NULL);
+    }
+    return true;
+}
@@ -0,0 +1 @@
+DEFERRED_EXEC_ENABLE = yes
@@ -18,7 +18,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdint.h>
 #include <stdbool.h>
 #include <gpio.h>
-#ifndef readPort
+#ifndef setPortBitOutput
 #    include "gpio_extr.h"
 #endif
 #include "util.h"
@@ -69,6 +69,8 @@ subcommands = [
     'qmk.cli.new.keymap',
     'qmk.cli.pyformat',
     'qmk.cli.pytest',
+    'qmk.cli.simulate',
+    'qmk.cli.telemetry',
     'qmk.cli.via2json',
 ]
 
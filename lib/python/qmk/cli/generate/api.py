@@ -1,22 +1,53 @@
 """This script automates the generation of the QMK API data.
 """
+from hashlib import sha1
 from pathlib import Path
-from shutil import copyfile
 import json
 
 from milc import cli
 
 from qmk.datetime import current_datetime
-from qmk.info import info_json
+from qmk.info import info_jsons
 from qmk.json_encoders import InfoJSONEncoder
 from qmk.json_schema import json_load
 from qmk.keyboard import find_readme, list_keyboards
 
 
+def _write_api_file(api_file, hashed, render, hashes, new_hashes, dry_run):
+    """Write `render()` to an API file, unless `hashed` is the same as in the previous run.
+
+    Returns True when the file is written.
+    """
+    content_hash = sha1(hashed).hexdigest()
+    new_hashes[api_file.as_posix()] = content_hash
+
+    if hashes.get(api_file.as_posix()) == content_hash and api_file.exists():
+        return False
+
+    if not dry_run:
+        api_file.parent.mkdir(parents=True, exist_ok=True)
+        api_file.write_bytes(render())
+        cli.log.debug('Wrote file %s', api_file)
+
+    return True
+
+
+def _write_api_json(api_file, data, hashes, new_hashes, dry_run, encoder=None):
+    """Write a JSON API file stamped with the current time.
+
+    Only `data` is hashed, so a file whose data is unchanged keeps its previous `last_updated`.
+    """
+    hashed = json.dumps(data, default=str).encode()
+
+    return _write_api_file(api_file, hashed, lambda: json.dumps({'last_updated': current_datetime(), **data}, cls=encoder).encode(), hashes, new_hashes, dry_run)
+
+
 @cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't write the data to disk.")
 @cli.subcommand('Creates a new keymap for the keyboard of your choosing', hidden=False if cli.config.user.developer else True)
 def generate_api(cli):
     """Generates the QMK API data.
+
+    The hash of every file written is kept in `api_data/hashes.json`. Files whose data has not changed since the previous run are left alone, along with their `last_updated` time, and files for keyboards that no longer exist are removed.
     """
     api_data_dir = Path('api_data')
     v1_dir = api_data_dir / 'v1'
@@ -25,30 +56,30 @@ def generate_api(cli):
     keyboard_aliases_file = v1_dir / 'keyboard_aliases.json'  # A list of historical keyboard names and their new name
     keyboard_metadata_file = v1_dir / 'keyboard_metadata.json'  # All the data configurator/via needs for initialization
     usb_file = v1_dir / 'usb.json'  # A mapping of USB VID/PID -> keyboard target
+    hashes_file = api_data_dir / 'hashes.json'  # The content hashes of the files written by the previous run
 
     if not api_data_dir.exists():
         api_data_dir.mkdir()
 
-    kb_all = {}
+    hashes = json_load(hashes_file) if hashes_file.exists() else {}
+    new_hashes = {}
+    written = 0
+
+    kb_all = info_jsons(list_keyboards())
     usb_list = {}
 
-    # Generate and write keyboard specific JSON files
-    for keyboard_name in list_keyboards():
-        kb_all[keyboard_name] = info_json(keyboard_name)
+    # Write keyboard specific JSON files
+    for keyboard_name in kb_all:
         keyboard_dir = v1_dir / 'keyboards' / keyboard_name
         keyboard_info = keyboard_dir / 'info.json'
         keyboard_readme = keyboard_dir / 'readme.md'
         keyboard_readme_src = find_readme(keyboard_name)
 
-        keyboard_dir.mkdir(parents=True, exist_ok=True)
-        keyboard_json = json.dumps({'last_updated': current_datetime(), 'keyboards': {keyboard_name: kb_all[keyboard_name]}})
-        if not cli.args.dry_run:
-            keyboard_info.write_text(keyboard_json)
-            cli.log.debug('Wrote file %s', keyboard_info)
+        written += _write_api_json(keyboard_info, {'keyboards': {keyboard_name: kb_all[keyboard_name]}}, hashes, new_hashes, cli.args.dry_run)
 
-            if keyboard_readme_src:
-                copyfile(keyboard_readme_src, keyboard_readme)
-                cli.log.debug('Copied %s -> %s', keyboard_readme_src, keyboard_readme)
+        if keyboard_readme_src:
+            readme = keyboard_readme_src.read_bytes()
+            written += _write_api_file(keyboard_readme, readme, lambda: readme, hashes, new_hashes, cli.args.dry_run)
 
         if 'usb' in kb_all[keyboard_name]:
             usb = kb_all[keyboard_name]['usb']
@@ -66,22 +97,36 @@ def generate_api(cli):
     keyboard_list = sorted(kb_all)
     keyboard_aliases = json_load(Path('data/mappings/keyboard_aliases.json'))
     keyboard_metadata = {
-        'last_updated': current_datetime(),
         'keyboards': keyboard_list,
         'keyboard_aliases': keyboard_aliases,
         'usb': usb_list,
     }
 
     # Write the global JSON files
-    keyboard_all_json = json.dumps({'last_updated': current_datetime(), 'keyboards': kb_all}, cls=InfoJSONEncoder)
-    usb_json = json.dumps({'last_updated': current_datetime(), 'usb': usb_list}, cls=InfoJSONEncoder)
-    keyboard_list_json = json.dumps({'last_updated': current_datetime(), 'keyboards': keyboard_list}, cls=InfoJSONEncoder)
-    keyboard_aliases_json = json.dumps({'last_updated': current_datetime(), 'keyboard_aliases': keyboard_aliases}, cls=InfoJSONEncoder)
-    keyboard_metadata_json = json.dumps(keyboard_metadata, cls=InfoJSONEncoder)
+    written += _write_api_json(keyboard_all_file, {'keyboards': kb_all}, hashes, new_hashes, cli.args.dry_run, InfoJSONEncoder)
+    written += _write_api_json(usb_file, {'usb': usb_list}, hashes, new_hashes, cli.args.dry_run, InfoJSONEncoder)
+    written += _write_api_json(keyboard_list_file, {'keyboards': keyboard_list}, hashes, new_hashes, cli.args.dry_run, InfoJSONEncoder)
+    written += _write_api_json(keyboard_aliases_file, {'keyboard_aliases': keyboard_aliases}, hashes, new_hashes, cli.args.dry_run, InfoJSONEncoder)
+    written += _write_api_json(keyboard_metadata_file, keyboard_metadata, hashes, new_hashes, cli.args.dry_run, InfoJSONEncoder)
+
+    # Remove the files of keyboards that have gone away
+    stale_files = [Path(api_file) for api_file in hashes if api_file not in new_hashes]
 
     if not cli.args.dry_run:
-        keyboard_all_file.write_text(keyboard_all_json)
-        usb_file.write_text(usb_json)
-        keyboard_list_file.write_text(keyboard_list_json)
-        keyboard_aliases_file.write_text(keyboard_aliases_json)
-        keyboard_metadata_file.write_text(keyboard_metadata_json)
+        for api_file in stale_files:
+            if api_file.exists():
+                api_file.unlink()
+                cli.log.debug('Removed file %s', api_file)
+
+            for parent in api_file.parents:
+                if parent == v1_dir or not parent.exists() or any(parent.iterdir()):
+                    break
+
+                parent.rmdir()
+
+        hashes_file.write_text(json.dumps(new_hashes, indent=4, sort_keys=True))
+
+    if cli.args.dry_run:
+        cli.log.info('Would write %d of %d API files and remove %d stale files.', written, len(new_hashes), len(stale_files))
+    else:
+        cli.log.info('Wrote %d of %d API files and removed %d stale files.', written, len(new_hashes), len(stale_files))
@@ -9,6 +9,7 @@ from qmk.commands import parse_configurator_json
 
 
 @cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-s', '--sparse', arg_only=True, action='store_true', help='Generate a sparse keymap for SPARSE_KEYMAP_ENABLE')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('filename', type=qmk.path.FileType('r'), arg_only=True, completer=FilesCompleter('.json'), help='Configurator JSON file')
 @cli.subcommand('Creates a keymap.c from a QMK Configurator export.')
@@ -26,7 +27,12 @@ def json2c(cli):
         cli.args.output = None
 
     # Generate the keymap
-    keymap_c = qmk.keymap.generate_c(user_keymap)
+    try:
+        keymap_c = qmk.keymap.generate_c(user_keymap, sparse=cli.args.sparse)
+
+    except ValueError as e:
+        cli.log.error('Could not generate a sparse keymap: %s', e)
+        return False
 
     if cli.args.output:
         cli.args.output.parent.mkdir(parents=True, exist_ok=True)
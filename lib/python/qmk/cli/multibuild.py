@@ -11,13 +11,14 @@ from milc import cli
 
 from qmk.constants import QMK_FIRMWARE
 from qmk.commands import _find_make, get_make_parallel_args
+from qmk.parallel import parallel_map
 import qmk.keyboard
 import qmk.keymap
 
 
-def _make_rules_mk_filter(key, value):
+def _make_rules_mk_filter(key, value, rules_mks):
     def _rules_mk_filter(keyboard_name):
-        rules_mk = qmk.keyboard.rules_mk(keyboard_name)
+        rules_mk = rules_mks[keyboard_name]
         return True if key in rules_mk and rules_mk[key].lower() == str(value).lower() else False
 
     return _rules_mk_filter
@@ -33,6 +34,7 @@ def _is_split(keyboard_name):
 @cli.argument('-f', '--filter', arg_only=True, action='append', default=[], help="Filter the list of keyboards based on the supplied value in rules.mk. Supported format is 'SPLIT_KEYBOARD=yes'. May be passed multiple times.")
 @cli.argument('-km', '--keymap', type=str, default='default', help="The keymap name to build. Default is 'default'.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
+@cli.argument('--object-cache', arg_only=True, action='store_true', help="Share compiled objects between keyboards with identical preprocessed sources and flags.")
 @cli.subcommand('Compile QMK Firmware for all keyboards.', hidden=False if cli.config.user.developer else True)
 def multibuild(cli):
     """Compile QMK Firmware against all keyboards.
@@ -47,14 +49,22 @@ def multibuild(cli):
 
     keyboard_list = qmk.keyboard.list_keyboards()
 
+    if cli.args.filter:
+        # Parse every rules.mk tree once, in parallel, and share the result between filters
+        rules_mks = dict(zip(keyboard_list, parallel_map(qmk.keyboard.rules_mk, keyboard_list)))
+
     filter_re = re.compile(r'^(?P<key>[A-Z0-9_]+)\s*=\s*(?P<value>[^#]+)$')
     for filter_txt in cli.args.filter:
         f = filter_re.match(filter_txt)
         if f is not None:
-            keyboard_list = filter(_make_rules_mk_filter(f.group('key'), f.group('value')), keyboard_list)
+            keyboard_list = filter(_make_rules_mk_filter(f.group('key'), f.group('value'), rules_mks), keyboard_list)
 
     keyboard_list = list(sorted(keyboard_list))
 
+    env = cli.args.env
+    if cli.args.object_cache:
+        env = ['OBJECT_CACHE=yes', *env]
+
     if len(keyboard_list) == 0:
         return
 
@@ -69,7 +79,7 @@ def multibuild(cli):
 all: {keyboard_safe}_binary
 {keyboard_safe}_binary:
 	@rm -f "{QMK_FIRMWARE}/.build/failed.log.{keyboard_safe}" || true
-	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{cli.args.keymap}" REQUIRE_PLATFORM_KEY= COLOR=true SILENT=false {' '.join(cli.args.env)} \\
+	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{cli.args.keymap}" REQUIRE_PLATFORM_KEY= COLOR=true SILENT=false {' '.join(env)} \\
 		>>"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" 2>&1 \\
 		|| cp "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" "{QMK_FIRMWARE}/.build/failed.log.{os.getpid()}.{keyboard_safe}"
 	@{{ grep '\[ERRORS\]' "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" >/dev/null 2>&1 && printf "Build %-64s \e[1;31m[ERRORS]\e[0m\\n" "{keyboard_name}:{cli.args.keymap}" ; }} \\
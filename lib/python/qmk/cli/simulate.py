@@ -0,0 +1,73 @@
+"""Run a keymap against a recorded trace of key events on the host.
+
+The keymap is built with `SIMULATE=yes`, which swaps the keyboard's MCU for a host executable that feeds the trace through the real matrix, debounce, action and report code.
+"""
+import sys
+from subprocess import DEVNULL
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+from qmk.decorators import automagic_keyboard, automagic_keymap
+from qmk.commands import create_make_command
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keymap import keymap_completer
+from qmk.path import normpath
+
+
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to simulate.')
+@cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to simulate.')
+@cli.argument('-t', '--trace', arg_only=True, default='-', completer=FilesCompleter('.txt'), help='The key event trace to replay. Defaults to stdin.')
+@cli.argument('-o', '--output', arg_only=True, default='-', help='File to write the reports to. Defaults to stdout.')
+@cli.argument('-s', '--skip-idle', arg_only=True, action='store_true', help="Skip most of the gaps without held keys. Only use this if no timer of the keymap runs that long.")
+@cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't actually build or run, just show the make command to be run.")
+@cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
+@cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
+@cli.subcommand('Run a keymap against a trace of key events on the host.', hidden=False if cli.config.user.developer else True)
+@automagic_keyboard
+@automagic_keymap
+def simulate(cli):
+    """Build a keymap for the host and replay a trace of key events through it.
+
+    Each line of the trace is `<time ms> <col> <row> <d|u>`. Every report the keymap sends is written to the output with the time it was sent at, and a throughput summary is printed once the trace has been replayed.
+    """
+    if not cli.config.simulate.keyboard:
+        cli.log.error('Could not determine keyboard!')
+        return False
+
+    if not cli.config.simulate.keymap:
+        cli.log.error('Could not determine keymap!')
+        return False
+
+    envs = {}
+    for env in cli.args.env:
+        if '=' in env:
+            key, value = env.split('=', 1)
+            envs[key] = value
+        else:
+            cli.log.warning('Invalid environment variable: %s', env)
+
+    envs['SIMULATE'] = 'yes'
+    if cli.args.skip_idle:
+        envs['SIMULATE_SKIP_IDLE'] = 'yes'
+
+    keyboard = cli.config.simulate.keyboard
+    keymap = cli.config.simulate.keymap
+    target = f'{keyboard.replace("/", "_")}_{keymap}_simulate'
+    command = create_make_command(keyboard, keymap, parallel=cli.config.simulate.parallel, **envs)
+
+    cli.log.info('Compiling keymap with {fg_cyan}%s', ' '.join(command))
+    if cli.args.dry_run:
+        return True
+
+    # Keep the build log off stdout, which may be carrying the reports
+    build = cli.run(command, capture_output=False, stdin=DEVNULL, stdout=sys.stderr)
+    if build.returncode:
+        return False
+
+    trace = cli.args.trace if cli.args.trace == '-' else str(normpath(cli.args.trace))
+    output = cli.args.output if cli.args.output == '-' else str(normpath(cli.args.output))
+    command = [f'.build/{target}.elf', trace, output]
+
+    cli.log.info('Replaying {fg_cyan}%s', trace)
+    return cli.run(command, capture_output=False).returncode == 0
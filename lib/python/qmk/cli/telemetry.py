@@ -0,0 +1,261 @@
+"""Show the telemetry records of a keyboard built with TELEMETRY_ENABLE.
+"""
+import re
+import struct
+import time
+from pathlib import Path
+
+from milc import cli
+
+from qmk.constants import QMK_FIRMWARE
+
+# Keep these in sync with quantum/telemetry/telemetry.h
+TELEMETRY_PACKET_ID = 0xFE
+TELEMETRY_PACKET_SIZE = 32
+TELEMETRY_STOP = 0x00
+TELEMETRY_START = 0x01
+TELEMETRY_TRACE = 0x05
+TELEMETRY_USER = 0x80
+
+RAW_USAGE_PAGE = 0xFF60
+RAW_USAGE_ID = 0x61
+
+# The keyboard stops recording after 3 seconds without a start packet
+KEEPALIVE_INTERVAL = 1
+
+RECORD_FORMATS = {
+    0x01: ('scan', '<HH', ('scans', 'longest_ms')),
+    0x02: ('layer', '<I', ('state',)),
+    0x03: ('transport_error', '<B', ('errors',)),
+    0x04: ('eeprom_write', '<HH', ('address', 'length')),
+}
+
+# Where trace statements are looked for besides the paths given with --source
+TRACE_SOURCE_PATHS = ('quantum', 'tmk_core', 'drivers', 'platforms')
+TRACE_STATEMENT = re.compile(r'\btrace_(?:error|warn|info|debug|verbose)\s*\(')
+TRACE_CONVERSION = re.compile(r'%([-+ 0#]*)(\d*)(?:hh|h|ll|l|z)?([diuxXobcs%])')
+STRING_LITERAL = r'"(?:[^"\\\n]|\\.)*"'
+STRING_TOKEN = re.compile(r'\s*(' + STRING_LITERAL + r'|\w+)')
+
+
+def _parse_string_expression(text, strings):
+    """Concatenates the string literals and string macros at the start of text, stopping at the first other token.
+    """
+    result = ''
+    token = STRING_TOKEN.match(text)
+    while token:
+        value = token.group(1)
+        if value.startswith('"'):
+            result += value[1:-1].encode().decode('unicode_escape')
+        elif value in strings:
+            result += strings[value]
+        else:
+            break
+        token = STRING_TOKEN.match(text, token.end())
+    return result
+
+
+def trace_file_id(path):
+    """Returns the ID trace statements in the file at path send, see TRACE_FILE_HASH in trace.h.
+
+    The keyboard hashes the path as it was passed to the compiler, which is relative to qmk_firmware for files inside it.
+    """
+    path = Path(path).resolve()
+    try:
+        path = path.relative_to(QMK_FIRMWARE.resolve())
+    except ValueError:
+        pass
+
+    file_hash = 0x811C9DC5
+    for byte in path.as_posix().encode()[:128].ljust(128, b'\0'):
+        file_hash = ((file_hash ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return (file_hash ^ (file_hash >> 16)) & 0xFFFF
+
+
+def load_trace_formats(paths):
+    """Maps the module ID, file ID and line of every trace statement below paths to its format string.
+
+    Statements that cannot be told apart, because the IDs of their files collide, are left out so that they are shown unformatted rather than with the wrong format.
+    """
+    trace_h = (QMK_FIRMWARE / 'quantum' / 'logging' / 'trace.h').read_text()
+    module_ids = {name: int(value, 0) for name, value in re.findall(r'#define TRACE_MODULE_ID_(\w+) (\w+)', trace_h)}
+    formats = {}
+    sources = {}
+    scanned = set()
+
+    for path in paths:
+        path = Path(path)
+        for source in sorted(path.rglob('*.c')) if path.is_dir() else [path]:
+            source = source.resolve()
+            if source in scanned:
+                continue
+            scanned.add(source)
+            text = source.read_text(errors='ignore')
+            if 'trace_' not in text:
+                continue
+
+            module = re.search(r'#define TRACE_MODULE (\w+)', text)
+            module_id = module_ids.get(module.group(1) if module else 'USER')
+            strings = {}
+            for name, value in re.findall(r'#\s*define (\w+) ((?:' + STRING_LITERAL + r'|\w+)(?:[ \t]+(?:' + STRING_LITERAL + r'|\w+))*)[ \t]*$', text, re.M):
+                if '"' in value:
+                    strings[name] = _parse_string_expression(value, strings)
+
+            file_id = trace_file_id(source)
+            for statement in TRACE_STATEMENT.finditer(text):
+                key = (module_id, file_id, text.count('\n', 0, statement.start()) + 1)
+                formats[key] = _parse_string_expression(text[statement.end():], strings)
+                sources.setdefault(key, set()).add(source)
+
+    for key, files in sources.items():
+        if len(files) > 1:
+            cli.log.warning('Not formatting the trace statements at line %d of %s, their files share an ID.', key[2], ', '.join(sorted(map(str, files))))
+            del formats[key]
+
+    return formats
+
+
+def format_trace(fmt, args):
+    """Formats the arguments of a trace statement the way the keyboard's printf would have.
+    """
+    args = list(args)
+
+    def convert(match):
+        flags, width, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+        if not args:
+            return '<missing>'
+
+        value = args.pop(0)
+        if conversion in 'di' and value >= 1 << 31:
+            value -= 1 << 32
+        if conversion == 'c':
+            return chr(value & 0xFF)
+        if conversion == 's':
+            return f'<string at {value:#x}>'
+        if conversion == 'b':
+            return format(value, flags.replace('-', '<') + width + 'b')
+        return ('%' + flags + width + conversion.replace('u', 'd')) % value
+
+    return TRACE_CONVERSION.sub(convert, fmt)
+
+
+def decode_packet(packet):
+    """Decode a telemetry packet into its sequence number, the number of records dropped before it and its records.
+
+    Returns None for packets that are not telemetry packets. Each record is a dict with the tag name, the keyboard timer in ms and the payload fields, or the raw payload bytes for keyboard and user records.
+    """
+    if len(packet) < 3 or packet[0] != TELEMETRY_PACKET_ID:
+        return None
+
+    sequence, dropped = packet[1], packet[2]
+    records = []
+    offset = 3
+    while offset + 4 <= len(packet) and packet[offset] != 0:
+        tag, length, timer = struct.unpack_from('<BBH', packet, offset)
+        if offset + 4 + length > len(packet):
+            # a record cut off by a short read cannot be decoded
+            break
+        payload = bytes(packet[offset + 4:offset + 4 + length])
+        offset += 4 + length
+
+        record = {'timer': timer}
+        if tag == TELEMETRY_TRACE and length >= 5 and (length - 5) % 4 == 0:
+            record['tag'] = 'trace'
+            record['module'], record['file'], record['line'] = struct.unpack_from('<BHH', payload)
+            record['args'] = struct.unpack_from(f'<{(length - 5) // 4}I', payload, 5)
+        elif tag in RECORD_FORMATS and struct.calcsize(RECORD_FORMATS[tag][1]) == length:
+            name, fmt, fields = RECORD_FORMATS[tag]
+            record['tag'] = name
+            record.update(zip(fields, struct.unpack(fmt, payload)))
+        else:
+            record['tag'] = f'user_{tag - TELEMETRY_USER}' if tag >= TELEMETRY_USER else f'unknown_{tag:02x}'
+            record['payload'] = payload.hex()
+        records.append(record)
+
+    return sequence, dropped, records
+
+
+def format_record(record, trace_formats=None):
+    """Format a decoded record as a single line, trace records with their format string from trace_formats if it is known.
+    """
+    if record['tag'] == 'trace' and trace_formats:
+        fmt = trace_formats.get((record['module'], record['file'], record['line']))
+        if fmt is not None:
+            return f'{record["timer"]:5d} {format_trace(fmt, record["args"])}'
+
+    fields = ' '.join(f'{key}={value:#010x}' if key == 'state' else f'{key}={value}' for key, value in record.items() if key not in ('timer', 'tag'))
+    return f'{record["timer"]:5d} {record["tag"]:<16} {fields}'
+
+
+def _find_device(device):
+    """Returns the raw HID interface of the first keyboard, or of the one matching VID:PID.
+    """
+    import hid
+
+    vid, pid = 0, 0
+    if device:
+        vid, pid = (int(value, 16) for value in device.split(':'))
+
+    for interface in hid.enumerate(vid, pid):
+        if interface['usage_page'] == RAW_USAGE_PAGE and interface['usage'] == RAW_USAGE_ID:
+            return interface
+    return None
+
+
+def _send_command(device, command):
+    # hidapi expects the report ID in front of the packet
+    device.write(bytes([0, TELEMETRY_PACKET_ID, command]).ljust(TELEMETRY_PACKET_SIZE + 1, b'\0'))
+
+
+@cli.argument('-s', '--source', arg_only=True, action='append', default=[], help='Additional file or directory to look for trace statements in, such as your keymap. May be passed multiple times.')
+@cli.argument('-d', '--device', arg_only=True, help='VID:PID of the keyboard in hex, defaults to the first raw HID device found')
+@cli.subcommand('Show live telemetry from a keyboard built with TELEMETRY_ENABLE.')
+def telemetry(cli):
+    """Streams and decodes the telemetry records of a keyboard until interrupted.
+    """
+    import hid
+
+    interface = _find_device(cli.args.device)
+    if not interface:
+        cli.log.error('No raw HID device found, is RAW_ENABLE or VIA_ENABLE set?')
+        return False
+
+    cli.log.info('Listening to {fg_cyan}%s %s{fg_reset}, press Ctrl-C to stop.', interface['manufacturer_string'], interface['product_string'])
+    device = hid.Device(path=interface['path'])
+    trace_formats = None
+    expected_sequence = None
+    keepalive = 0
+
+    try:
+        while True:
+            if time.monotonic() - keepalive >= KEEPALIVE_INTERVAL:
+                _send_command(device, TELEMETRY_START)
+                keepalive = time.monotonic()
+
+            packet = device.read(TELEMETRY_PACKET_SIZE, 100)
+            decoded = decode_packet(packet) if packet else None
+            if not decoded:
+                continue
+
+            sequence, dropped, records = decoded
+            if expected_sequence is not None and sequence != expected_sequence:
+                cli.log.warning('Lost %d packets', (sequence - expected_sequence) % 256)
+            if dropped:
+                cli.log.warning('Keyboard dropped %d records', dropped)
+            expected_sequence = (sequence + 1) % 256
+
+            for record in records:
+                if record['tag'] == 'trace' and trace_formats is None:
+                    trace_formats = load_trace_formats([QMK_FIRMWARE / path for path in TRACE_SOURCE_PATHS] + cli.args.source)
+                cli.echo(format_record(record, trace_formats))
+
+    except KeyboardInterrupt:
+        pass
+
+    finally:
+        _send_command(device, TELEMETRY_STOP)
+        device.close()
+
+    return True
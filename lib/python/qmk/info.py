@@ -14,6 +14,8 @@ from qmk.keyboard import config_h, rules_mk
 from qmk.keymap import list_keymaps
 from qmk.makefile import parse_rules_mk_file
 from qmk.math import compute
+from qmk.parallel import parallel_map
+import qmk.info_cache
 
 true_values = ['1', 'on', 'yes']
 false_values = ['0', 'off', 'no']
@@ -34,6 +36,43 @@ def _remove_newlines_from_labels(layouts):
 
 def info_json(keyboard):
     """Generate the info.json data for a specific keyboard.
+
+    The result is cached under `.build/info_cache` until one of the files it was generated from changes. The errors and warnings found while generating it are logged again when it comes from the cache.
+    """
+    return info_jsons([keyboard])[keyboard]
+
+
+def info_jsons(keyboards):
+    """Generate the info.json data for many keyboards, using a pool of worker processes for those not already cached.
+
+    Returns a dictionary of keyboard name to info.json data.
+    """
+    stamps = {keyboard: qmk.info_cache.keyboard_stamp(keyboard) for keyboard in keyboards}
+    kb_all = {}
+    missing = []
+
+    for keyboard, stamp in stamps.items():
+        kb_all[keyboard] = qmk.info_cache.load(keyboard, stamp)
+
+        if kb_all[keyboard] is None:
+            missing.append(keyboard)
+
+        else:
+            for message in kb_all[keyboard]['parse_warnings']:
+                cli.log.warning('%s: %s', kb_all[keyboard]['keyboard_folder'], message)
+
+            for message in kb_all[keyboard]['parse_errors']:
+                cli.log.error('%s: %s', kb_all[keyboard]['keyboard_folder'], message)
+
+    for keyboard, info_data in zip(missing, parallel_map(_generate_info_json, missing)):
+        kb_all[keyboard] = info_data
+        qmk.info_cache.store(keyboard, stamps[keyboard], info_data)
+
+    return kb_all
+
+
+def _generate_info_json(keyboard):
+    """Parse the keyboard folder hierarchy into info.json data.
     """
     cur_dir = Path('keyboards')
     root_rules_mk = parse_rules_mk_file(cur_dir / keyboard / 'rules.mk')
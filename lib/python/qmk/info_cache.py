@@ -0,0 +1,113 @@
+"""Persistent cache of resolved keyboard info.json data.
+
+Resolving a keyboard means parsing every config.h, rules.mk, keyboard.h and info.json in its folder hierarchy. The result is kept under `.build/info_cache` together with a digest of the names, modification times and sizes of the files it was built from. A cached entry is only used while that digest is unchanged.
+"""
+import hashlib
+import os
+import pickle
+from functools import lru_cache
+from pathlib import Path
+from tempfile import NamedTemporaryFile
+
+from qmk.keyboard import resolve_keyboard
+
+CACHE_DIR = Path('.build/info_cache')
+
+# Anything outside the keyboard folders that info_json() reads
+GLOBAL_SOURCES = 'data', 'layouts/default', 'layouts/community', 'lib/python/qmk'
+
+
+def _dir_stamp(path):
+    """Returns the name, modification time and size of every entry in a directory.
+    """
+    try:
+        with os.scandir(path) as entries:
+            stamp = []
+            for entry in entries:
+                stat = entry.stat(follow_symlinks=False)
+                stamp.append((entry.name, stat.st_mtime_ns, stat.st_size))
+            return sorted(stamp)
+
+    except OSError:
+        return None
+
+
+@lru_cache(maxsize=None)
+def _global_stamp():
+    """Stamps the schemas, mappings, community layouts and library code shared by all keyboards.
+    """
+    stamp = []
+
+    for source in GLOBAL_SOURCES:
+        for root, dirs, files in os.walk(source):
+            dirs[:] = [d for d in dirs if d != '__pycache__']
+            stamp.append((root, _dir_stamp(root)))
+
+    return hashlib.sha1(repr(stamp).encode()).hexdigest()
+
+
+def _keyboard_dirs(keyboard):
+    """Returns each folder from `keyboards/` down to `keyboard`.
+    """
+    parts = str(keyboard).split('/')
+
+    return ['/'.join(['keyboards', *parts[:i + 1]]) for i in range(len(parts))]
+
+
+def keyboard_stamp(keyboard):
+    """Returns a digest of every file that can contribute to the info.json data of a keyboard.
+
+    This covers the folders leading to both the requested and the DEFAULT_FOLDER resolved keyboard, along with their keymaps.
+    """
+    dirs = set(_keyboard_dirs(keyboard)) | set(_keyboard_dirs(resolve_keyboard(keyboard)))
+    stamp = [_global_stamp()]
+
+    for keyboard_dir in sorted(dirs):
+        dir_stamp = _dir_stamp(keyboard_dir)
+        stamp.append((keyboard_dir, dir_stamp))
+
+        if dir_stamp and any(name == 'keymaps' for name, _, _ in dir_stamp):
+            keymaps_dir = keyboard_dir + '/keymaps'
+            for keymap, _, _ in _dir_stamp(keymaps_dir) or []:
+                stamp.append((keymap, _dir_stamp(f'{keymaps_dir}/{keymap}')))
+
+    return hashlib.sha1(repr(stamp).encode()).hexdigest()
+
+
+def _cache_file(keyboard):
+    return CACHE_DIR / 'keyboards' / keyboard / 'info.pickle'
+
+
+def load(keyboard, stamp):
+    """Returns the cached info.json data for a keyboard, or None when missing or stale.
+    """
+    try:
+        with _cache_file(keyboard).open('rb') as cache_file:
+            cached = pickle.load(cache_file)
+
+    except Exception:
+        return None
+
+    if cached.get('stamp') != stamp:
+        return None
+
+    return cached['info_data']
+
+
+def store(keyboard, stamp, info_data):
+    """Writes the info.json data for a keyboard to the cache.
+
+    The file is renamed into place so that parallel resolvers never read a partial entry. A read-only tree simply goes uncached.
+    """
+    cache_file = _cache_file(keyboard)
+
+    try:
+        cache_file.parent.mkdir(parents=True, exist_ok=True)
+
+        with NamedTemporaryFile('wb', dir=cache_file.parent, delete=False) as temp_file:
+            pickle.dump({'stamp': stamp, 'info_data': info_data}, temp_file, pickle.HIGHEST_PROTOCOL)
+
+        os.replace(temp_file.name, cache_file)
+
+    except OSError:
+        pass
@@ -1,6 +1,7 @@
 """Functions that help you work with QMK keymaps.
 """
 import json
+import re
 import sys
 from pathlib import Path
 from subprocess import DEVNULL
@@ -67,6 +68,13 @@ def template_c(keyboard):
     return template
 
 
+# The keymaps declaration of the `keymap.c` templates, which a sparse keymap replaces
+KEYMAPS_DECLARATION = re.compile(r'const uint16_t PROGMEM keymaps\[\]\[MATRIX_ROWS\]\[MATRIX_COLS\] = \{\s*__KEYMAP_GOES_HERE__\s*\};')
+
+TRANSPARENT_KEYCODES = ('KC_TRANSPARENT', 'KC_TRNS', '_______')
+NO_KEYCODES = ('KC_NO', 'XXXXXXX')
+
+
 def _strip_any(keycode):
     """Remove ANY() from a keycode.
     """
@@ -187,7 +195,61 @@ def generate_json(keymap, keyboard, layout, layers, macros=None):
     return new_keymap
 
 
-def generate_c(keymap_json):
+def generate_sparse_keymap(keymap_json):
+    """Returns the sparse keymap tables that replace `keymaps[][][]` when SPARSE_KEYMAP_ENABLE is set.
+
+    Each layer stores a bitmap of the keys that differ from the layer's default, KC_NO on layer 0 and KC_TRANSPARENT above it, the offset of every row's first stored keycode and the stored keycodes themselves. See quantum/keymap.h.
+    """
+    from qmk.info import info_json  # qmk.info imports this module
+
+    info = info_json(keymap_json['keyboard'])
+    layout_name = info.get('layout_aliases', {}).get(keymap_json['layout'], keymap_json['layout'])
+    if layout_name not in info.get('layouts', {}):
+        raise ValueError(f'Layout {keymap_json["layout"]} not found for keyboard {keymap_json["keyboard"]}')
+
+    layout = info['layouts'][layout_name]['layout']
+    rows, cols = info['matrix_size']['rows'], info['matrix_size']['cols']
+    masks, offsets, keycodes = [], [], []
+
+    for layer_num, layer in enumerate(keymap_json['layers']):
+        if len(layer) != len(layout):
+            raise ValueError(f'Layer {layer_num} has {len(layer)} keys, {layout_name} has {len(layout)}')
+
+        default = NO_KEYCODES if layer_num == 0 else TRANSPARENT_KEYCODES
+        matrix = [[None] * cols for _ in range(rows)]
+        for key, keycode in zip(layout, layer):
+            keycode = _strip_any(keycode)
+            if keycode not in default:
+                row, col = key['matrix']
+                matrix[row][col] = keycode
+
+        layer_masks, layer_offsets, layer_keycodes = [], [], []
+        for row in matrix:
+            layer_offsets.append(str(len(keycodes) + len(layer_keycodes)))
+            layer_masks.append('0x%X' % sum(1 << col for col, keycode in enumerate(row) if keycode))
+            layer_keycodes.extend(keycode for keycode in row if keycode)
+
+        masks.append(f'\t[{layer_num}] = {{{", ".join(layer_masks)}}}')
+        offsets.append(f'\t[{layer_num}] = {{{", ".join(layer_offsets)}}}')
+        keycodes.extend(layer_keycodes)
+
+    return '\n'.join((
+        'const matrix_row_t PROGMEM sparse_keymap_masks[][MATRIX_ROWS] = {',
+        ',\n'.join(masks),
+        '};',
+        '',
+        'const uint16_t PROGMEM sparse_keymap_offsets[][MATRIX_ROWS] = {',
+        ',\n'.join(offsets),
+        '};',
+        '',
+        'const uint16_t PROGMEM sparse_keymap_keycodes[] = {',
+        # a layer without any stored key would leave the array empty
+        '\t' + ', '.join(keycodes or ['KC_NO']),
+        '};',
+    ))
+
+
+def generate_c(keymap_json, sparse=False):
     """Returns a `keymap.c`.
 
     `keymap_json` is a dictionary with the following keys:
@@ -203,19 +265,28 @@ def generate_c(keymap_json):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+    With `sparse` the layers are written as the tables of a sparse keymap instead of `keymaps[][][]`.
     """
     new_keymap = template_c(keymap_json['keyboard'])
-    layer_txt = []
 
-    for layer_num, layer in enumerate(keymap_json['layers']):
-        if layer_num != 0:
-            layer_txt[-1] = layer_txt[-1] + ','
-        layer = map(_strip_any, layer)
-        layer_keys = ', '.join(layer)
-        layer_txt.append('\t[%s] = %s(%s)' % (layer_num, keymap_json['layout'], layer_keys))
-
-    keymap = '\n'.join(layer_txt)
-    new_keymap = new_keymap.replace('__KEYMAP_GOES_HERE__', keymap)
+    if sparse:
+        if not KEYMAPS_DECLARATION.search(new_keymap):
+            raise ValueError(f'The keymap.c template of {keymap_json["keyboard"]} does not declare keymaps[][][] the way a sparse keymap can replace')
+        new_keymap = KEYMAPS_DECLARATION.sub(lambda match: generate_sparse_keymap(keymap_json), new_keymap)
+
+    else:
+        layer_txt = []
+
+        for layer_num, layer in enumerate(keymap_json['layers']):
+            if layer_num != 0:
+                layer_txt[-1] = layer_txt[-1] + ','
+            layer = map(_strip_any, layer)
+            layer_keys = ', '.join(layer)
+            layer_txt.append('\t[%s] = %s(%s)' % (layer_num, keymap_json['layout'], layer_keys))
+
+        keymap = '\n'.join(layer_txt)
+        new_keymap = new_keymap.replace('__KEYMAP_GOES_HERE__', keymap)
 
     if keymap_json.get('macros'):
         macro_txt = [
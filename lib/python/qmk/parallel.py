@@ -0,0 +1,18 @@
+"""Run per-keyboard work across a pool of processes.
+"""
+import multiprocessing
+from concurrent.futures import ProcessPoolExecutor
+
+
+def parallel_map(func, items, chunksize=16):
+    """Returns a list of `func(item)` for each item, computed in worker processes.
+
+    Workers are forked so they inherit the configured `cli` object and its logging. Platforms without fork, and lists too short to be worth a pool, are processed in this process.
+    """
+    items = list(items)
+
+    if len(items) < 2 or 'fork' not in multiprocessing.get_all_start_methods():
+        return list(map(func, items))
+
+    with ProcessPoolExecutor(mp_context=multiprocessing.get_context('fork')) as executor:
+        return list(executor.map(func, items, chunksize=chunksize))
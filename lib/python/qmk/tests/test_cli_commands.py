@@ -1,4 +1,5 @@
 import platform
+import re
 from subprocess import DEVNULL
 
 from milc import cli
@@ -51,6 +52,20 @@ def test_compile_json():
     check_returncode(result)
 
 
+def test_simulate():
+    result = check_subcommand('simulate', '-kb', 'handwired/pytest/basic', '-km', 'default_json', '-n')
+    check_returncode(result)
+    assert 'SIMULATE=yes' in result.stdout
+
+
+def test_simulate_trace():
+    result = check_subcommand('simulate', '-kb', 'handwired/pytest/basic', '-km', 'simulate', '-t', 'lib/python/qmk/tests/simulate_trace.txt')
+    check_returncode(result)
+    reports = [line for line in result.stdout.splitlines() if re.fullmatch(r'\d+ keyboard( [0-9A-F]{2})+', line)]
+    # the deferred tap of B runs 3 s after the first release, in the middle of the idle gap
+    assert reports == ['5 keyboard 00 04', '55 keyboard 00', '3055 keyboard 00 05', '3055 keyboard 00', '5005 keyboard 00 04', '5055 keyboard 00']
+
+
 def test_flash():
     result = check_subcommand('flash', '-kb', 'handwired/pytest/basic', '-km', 'default', '-n')
     check_returncode(result)
@@ -177,6 +192,14 @@ def test_info():
     assert 'k0' not in result.stdout
 
 
+def test_info_cached():
+    first = check_subcommand('info', '-kb', 'handwired/pytest/basic', '-l')
+    second = check_subcommand('info', '-kb', 'handwired/pytest/basic', '-l')
+    check_returncode(first)
+    check_returncode(second)
+    assert first.stdout == second.stdout
+
+
 def test_info_keyboard_render():
     result = check_subcommand('info', '-kb', 'handwired/pytest/basic', '-l')
     check_returncode(result)
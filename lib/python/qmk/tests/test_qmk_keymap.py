@@ -32,6 +32,20 @@ def test_generate_c_pytest_has_template():
     assert templ == '#include QMK_KEYBOARD_H\nconst uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {\t[0] = LAYOUT(KC_A)};\n'
 
 
+def test_generate_c_sparse_pytest_basic():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT_custom',
+        'layers': [['KC_A'], ['KC_TRNS']],
+        'macros': None,
+    }
+    templ = qmk.keymap.generate_c(keymap_json, sparse=True)
+    assert 'keymaps[]' not in templ
+    assert 'const matrix_row_t PROGMEM sparse_keymap_masks[][MATRIX_ROWS] = {\n\t[0] = {0x1},\n\t[1] = {0x0}\n};' in templ
+    assert 'const uint16_t PROGMEM sparse_keymap_offsets[][MATRIX_ROWS] = {\n\t[0] = {0},\n\t[1] = {1}\n};' in templ
+    assert 'const uint16_t PROGMEM sparse_keymap_keycodes[] = {\n\tKC_A\n};' in templ
+
+
 def test_generate_json_pytest_has_template():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/has_template', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/has_template", "documentation": "This file is a keymap.json file for handwired/pytest/has_template", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
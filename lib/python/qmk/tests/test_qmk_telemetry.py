@@ -0,0 +1,83 @@
+import tempfile
+from pathlib import Path
+from unittest import mock
+
+import qmk.cli.telemetry
+
+
+def test_trace_file_id_matches_firmware():
+    # quantum/telemetry/tests/telemetry_tests.cpp checks the same ID
+    assert qmk.cli.telemetry.trace_file_id('quantum/telemetry/tests/telemetry_tests.cpp') == 0xC286
+
+
+def test_load_trace_formats():
+    with tempfile.TemporaryDirectory() as source:
+        path = Path(source) / 'keymap.c'
+        path.write_text('#include "trace.h"\n\nvoid f(int a) {\n    trace_info("a=%d", a);\n}\n')
+        formats = qmk.cli.telemetry.load_trace_formats([source])
+
+    assert formats == {(0x81, qmk.cli.telemetry.trace_file_id(path), 4): 'a=%d'}
+
+
+def test_load_trace_formats_skips_shared_ids():
+    with tempfile.TemporaryDirectory() as source:
+        (Path(source) / 'keymap.c').write_text('trace_info("keymap");\ntrace_info("keymap only");\n')
+        (Path(source) / 'user.c').write_text('trace_info("user");\n')
+        with mock.patch('qmk.cli.telemetry.trace_file_id', return_value=1):
+            formats = qmk.cli.telemetry.load_trace_formats([source])
+
+    assert formats == {(0x81, 1, 2): 'keymap only'}
+
+
+def test_load_trace_formats_module_and_macros():
+    with tempfile.TemporaryDirectory() as source:
+        path = Path(source) / 'action_tapping.c'
+        path.write_text('#define TRACE_MODULE TAPPING\n#define PREFIX "tap "\ntrace_debug(PREFIX "%u" " done", 1);\n')
+        formats = qmk.cli.telemetry.load_trace_formats([source])
+
+    assert formats == {(0x01, qmk.cli.telemetry.trace_file_id(path), 3): 'tap %u done'}
+
+
+def test_decode_packet():
+    packet = bytes([0xFE, 7, 2])
+    packet += bytes([0x02, 4, 0x10, 0x00, 0x78, 0x56, 0x34, 0x12])
+    packet += bytes([0x05, 9, 0x20, 0x00, 0x81, 0x86, 0xC2, 0x2A, 0x00, 0xFE, 0xFF, 0xFF, 0xFF])
+    packet = packet.ljust(32, b'\0')
+
+    assert qmk.cli.telemetry.decode_packet(packet) == (7, 2, [
+        {'timer': 0x10, 'tag': 'layer', 'state': 0x12345678},
+        {'timer': 0x20, 'tag': 'trace', 'module': 0x81, 'file': 0xC286, 'line': 42, 'args': (0xFFFFFFFE,)},
+    ])
+
+
+def test_decode_packet_short():
+    assert qmk.cli.telemetry.decode_packet(bytes([0xFE, 0])) is None
+    assert qmk.cli.telemetry.decode_packet(bytes([0x01, 0, 0]).ljust(32, b'\0')) is None
+
+    # the second record claims more bytes than were read
+    packet = bytes([0xFE, 0, 0, 0x03, 1, 0, 0, 5, 0x05, 13, 0, 0, 0x81, 0, 0, 1, 0])
+    assert qmk.cli.telemetry.decode_packet(packet) == (0, 0, [{'timer': 0, 'tag': 'transport_error', 'errors': 5}])
+
+
+def test_decode_packet_unknown_tag():
+    packet = bytes([0xFE, 0, 0, 0x7F, 2, 1, 0, 0xAB, 0xCD, 0x82, 1, 2, 0, 0xEF, 0x01, 1, 3, 0, 9]).ljust(32, b'\0')
+
+    assert qmk.cli.telemetry.decode_packet(packet) == (0, 0, [
+        {'timer': 1, 'tag': 'unknown_7f', 'payload': 'abcd'},
+        {'timer': 2, 'tag': 'user_2', 'payload': 'ef'},
+        # a known tag with a payload of the wrong size is shown raw as well
+        {'timer': 3, 'tag': 'unknown_01', 'payload': '09'},
+    ])
+
+
+def test_format_trace():
+    assert qmk.cli.telemetry.format_trace('%d %u %04X %c %08b 100%%', (0xFFFFFFFE, 300, 300, 0x41, 5)) == '-2 300 012C A 00000101 100%'
+    assert qmk.cli.telemetry.format_trace('%s %lu %d', (0x1234, 7)) == '<string at 0x1234> 7 <missing>'
+
+
+def test_format_record():
+    trace = {'timer': 20, 'tag': 'trace', 'module': 0x81, 'file': 1, 'line': 42, 'args': (3,)}
+
+    assert qmk.cli.telemetry.format_record(trace, {(0x81, 1, 42): 'count %u'}) == '   20 count 3'
+    assert qmk.cli.telemetry.format_record(trace, {(0x81, 2, 42): 'count %u'}) == '   20 trace            module=129 file=1 line=42 args=(3,)'
+    assert qmk.cli.telemetry.format_record({'timer': 5, 'tag': 'layer', 'state': 2}) == '    5 layer            state=0x00000002'
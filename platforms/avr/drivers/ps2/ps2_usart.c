@@ -46,6 +46,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "ps2.h"
 #include "ps2_io.h"
 #include "print.h"
+#include "ring_buffer.h"
 
 #ifndef PS2_CLOCK_DDR
 #    define PS2_CLOCK_DDR PORTx_ADDRESS(PS2_CLOCK_PIN)
@@ -70,10 +71,11 @@ POSSIBILITY OF SUCH DAMAGE.
 
 uint8_t ps2_error = PS2_ERR_NONE;
 
-static inline uint8_t pbuf_dequeue(void);
-static inline void    pbuf_enqueue(uint8_t data);
-static inline bool    pbuf_has_data(void);
-static inline void    pbuf_clear(void);
+/*--------------------------------------------------------------------
+ * Ring buffer to store scan codes from keyboard
+ *------------------------------------------------------------------*/
+#define PBUF_SIZE 32
+RING_BUFFER_DECLARE(pbuf, uint8_t, PBUF_SIZE);
 
 void ps2_host_init(void) {
     idle(); // without this many USART errors occur when cable is disconnected
@@ -150,13 +152,16 @@ uint8_t ps2_host_recv_response(void) {
     while (retry-- && !pbuf_has_data()) {
         _delay_ms(1);
     }
-    return pbuf_dequeue();
+    uint8_t data = 0;
+    pbuf_dequeue(&data);
+    return data;
 }
 
 uint8_t ps2_host_recv(void) {
-    if (pbuf_has_data()) {
+    uint8_t data = 0;
+    if (pbuf_dequeue(&data)) {
         ps2_error = PS2_ERR_NONE;
-        return pbuf_dequeue();
+        return data;
     } else {
         ps2_error = PS2_ERR_NODATA;
         return 0;
@@ -168,7 +173,9 @@ ISR(PS2_USART_RX_VECT) {
     uint8_t error = PS2_USART_ERROR; // USART error should be read before data
     uint8_t data  = PS2_USART_RX_DATA;
     if (!error) {
-        pbuf_enqueue(data);
+        if (!pbuf_enqueue(data)) {
+            print("pbuf: full\n");
+        }
     } else {
         xprintf("PS2 USART error: %02X data: %02X\n", error, data);
     }
@@ -179,49 +186,3 @@ void ps2_host_set_led(uint8_t led) {
     ps2_host_send(0xED);
     ps2_host_send(led);
 }
-
-/*--------------------------------------------------------------------
- * Ring buffer to store scan codes from keyboard
- *------------------------------------------------------------------*/
-#define PBUF_SIZE 32
-static uint8_t     pbuf[PBUF_SIZE];
-static uint8_t     pbuf_head = 0;
-static uint8_t     pbuf_tail = 0;
-static inline void pbuf_enqueue(uint8_t data) {
-    uint8_t sreg = SREG;
-    cli();
-    uint8_t next = (pbuf_head + 1) % PBUF_SIZE;
-    if (next != pbuf_tail) {
-        pbuf[pbuf_head] = data;
-        pbuf_head       = next;
-    } else {
-        print("pbuf: full\n");
-    }
-    SREG = sreg;
-}
-static inline uint8_t pbuf_dequeue(void) {
-    uint8_t val = 0;
-
-    uint8_t sreg = SREG;
-    cli();
-    if (pbuf_head != pbuf_tail) {
-        val       = pbuf[pbuf_tail];
-        pbuf_tail = (pbuf_tail + 1) % PBUF_SIZE;
-    }
-    SREG = sreg;
-
-    return val;
-}
-static inline bool pbuf_has_data(void) {
-    uint8_t sreg = SREG;
-    cli();
-    bool has_data = (pbuf_head != pbuf_tail);
-    SREG          = sreg;
-    return has_data;
-}
-static inline void pbuf_clear(void) {
-    uint8_t sreg = SREG;
-    cli();
-    pbuf_head = pbuf_tail = 0;
-    SREG                  = sreg;
-}
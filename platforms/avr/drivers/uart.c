@@ -28,6 +28,7 @@
 #include <avr/interrupt.h>
 
 #include "uart.h"
+#include "ring_buffer.h"
 
 #if defined(__AVR_AT90USB162__) || defined(__AVR_ATmega16U2__) || defined(__AVR_ATmega32U2__) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__) || defined(__AVR_AT90USB646__) || defined(__AVR_AT90USB647__) || defined(__AVR_AT90USB1286__) || defined(__AVR_AT90USB1287__)
 #    define UDRn UDR1
@@ -80,52 +81,37 @@
 #define RX_BUFFER_SIZE 64
 #define TX_BUFFER_SIZE 256
 
-static volatile uint8_t tx_buffer[TX_BUFFER_SIZE];
-static volatile uint8_t tx_buffer_head;
-static volatile uint8_t tx_buffer_tail;
-static volatile uint8_t rx_buffer[RX_BUFFER_SIZE];
-static volatile uint8_t rx_buffer_head;
-static volatile uint8_t rx_buffer_tail;
+RING_BUFFER_DECLARE(tx_buffer, uint8_t, TX_BUFFER_SIZE);
+RING_BUFFER_DECLARE(rx_buffer, uint8_t, RX_BUFFER_SIZE);
 
 // Initialize the UART
 void uart_init(uint32_t baud) {
     cli();
-    UBRRnL         = (F_CPU / 4 / baud - 1) / 2;
-    UCSRnA         = (1 << U2Xn);
-    UCSRnB         = (1 << RXENn) | (1 << TXENn) | (1 << RXCIEn);
-    UCSRnC         = (1 << UCSZn1) | (1 << UCSZn0);
-    tx_buffer_head = tx_buffer_tail = 0;
-    rx_buffer_head = rx_buffer_tail = 0;
+    UBRRnL = (F_CPU / 4 / baud - 1) / 2;
+    UCSRnA = (1 << U2Xn);
+    UCSRnB = (1 << RXENn) | (1 << TXENn) | (1 << RXCIEn);
+    UCSRnC = (1 << UCSZn1) | (1 << UCSZn0);
+    tx_buffer_clear();
+    rx_buffer_clear();
     sei();
 }
 
 // Transmit a byte
 void uart_write(uint8_t data) {
-    uint8_t i;
-
-    i = tx_buffer_head + 1;
-    if (i >= TX_BUFFER_SIZE) i = 0;
-    // return immediately to avoid deadlock when interrupt is disabled(called from ISR)
-    if (tx_buffer_tail == i && (SREG & (1 << SREG_I)) == 0) return;
-    while (tx_buffer_tail == i)
-        ; // wait until space in buffer
-    // cli();
-    tx_buffer[i]   = data;
-    tx_buffer_head = i;
-    UCSRnB         = (1 << RXENn) | (1 << TXENn) | (1 << RXCIEn) | (1 << UDRIEn);
-    // sei();
+    while (!tx_buffer_enqueue(data)) {
+        // return immediately to avoid deadlock when interrupt is disabled(called from ISR)
+        if ((SREG & (1 << SREG_I)) == 0) return;
+        // wait until space in buffer
+    }
+    UCSRnB = (1 << RXENn) | (1 << TXENn) | (1 << RXCIEn) | (1 << UDRIEn);
 }
 
 // Receive a byte
 uint8_t uart_read(void) {
-    uint8_t data, i;
+    uint8_t data;
 
-    while (rx_buffer_head == rx_buffer_tail)
+    while (!rx_buffer_dequeue(&data))
         ; // wait for character
-    i = rx_buffer_tail + 1;
-    if (i >= RX_BUFFER_SIZE) i = 0;
-    data           = rx_buffer[i];
-    rx_buffer_tail = i;
     return data;
 }
 
@@ -145,38 +131,22 @@ void uart_receive(uint8_t *data, uint16_t length) {
 // Call this before uart_read() to check if it will need
 // to wait for a byte to arrive.
 bool uart_available(void) {
-    uint8_t head, tail;
-
-    head = rx_buffer_head;
-    tail = rx_buffer_tail;
-    if (head >= tail) return (head - tail) > 0;
-    return (RX_BUFFER_SIZE + head - tail) > 0;
+    return rx_buffer_has_data();
 }
 
 // Transmit Interrupt
 ISR(USARTn_UDRE_vect) {
-    uint8_t i;
+    uint8_t data;
 
-    if (tx_buffer_head == tx_buffer_tail) {
+    if (tx_buffer_dequeue(&data)) {
+        UDRn = data;
+    } else {
         // buffer is empty, disable transmit interrupt
         UCSRnB = (1 << RXENn) | (1 << TXENn) | (1 << RXCIEn);
-    } else {
-        i = tx_buffer_tail + 1;
-        if (i >= TX_BUFFER_SIZE) i = 0;
-        UDRn           = tx_buffer[i];
-        tx_buffer_tail = i;
     }
 }
 
 // Receive Interrupt
 ISR(USARTn_RX_vect) {
-    uint8_t c, i;
-
-    c = UDRn;
-    i = rx_buffer_head + 1;
-    if (i >= RX_BUFFER_SIZE) i = 0;
-    if (i != rx_buffer_tail) {
-        rx_buffer[i]   = c;
-        rx_buffer_head = i;
-    }
+    rx_buffer_enqueue(UDRn);
 }
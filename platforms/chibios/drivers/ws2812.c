@@ -82,7 +82,7 @@ void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
     // this code is very time dependent, so we need to disable interrupts
     chSysLock();
 
-    for (uint8_t i = 0; i < leds; i++) {
+    for (uint16_t i = 0; i < leds; i++) {
         // WS2812 protocol dictates grb order
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
         sendByte(ledarray[i].g);
@@ -101,9 +101,18 @@ void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
 #ifdef RGBW
         sendByte(ledarray[i].w);
 #endif
-    }
 
-    wait_ns(WS2812_RES);
+#ifdef WS2812_BITBANG_LEDS_PER_LOCK
+        // the line idles low between LEDs, so pending interrupts can run as long as they finish before the LEDs latch
+        if ((i + 1) % WS2812_BITBANG_LEDS_PER_LOCK == 0) {
+            chSysUnlock();
+            chSysLock();
+        }
+#endif
+    }
 
     chSysUnlock();
+
+    // the reset gap only needs the line to stay low, interrupts just make it longer
+    wait_ns(WS2812_RES);
 }
@@ -1,6 +1,7 @@
 #include "ws2812.h"
 #include "quantum.h"
 #include <hal.h>
+#include <string.h>
 
 /* Adapted from https://github.com/joewa/WS2812-LED-Driver_ChibiOS/ */
 
@@ -59,6 +60,14 @@
 #    define WS2812_PWM_TARGET_PERIOD 80000 // TODO: work out why 10x less on f303/f4x1
 #endif
 
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+#    define WS2812_BUFFER_N 2
+#    define WS2812_DMA_INTERRUPTS STM32_DMA_CR_TCIE
+#else
+#    define WS2812_BUFFER_N 1
+#    define WS2812_DMA_INTERRUPTS 0
+#endif
+
 /* --- PRIVATE CONSTANTS ---------------------------------------------------- */
 
 #define WS2812_PWM_FREQUENCY (CPU_CLOCK / 2)                                /**< Clock frequency of PWM, must be valid with respect to system clock! */
@@ -106,6 +115,13 @@
  */
 #define WS2812_DUTYCYCLE_1 (WS2812_PWM_FREQUENCY / (1000000000 / 800))
 
+/**
+ * @brief   DMA stream configuration
+ *
+ * M2P: Memory 2 Periph; PL: Priority Level
+ */
+#define WS2812_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3) | WS2812_DMA_INTERRUPTS)
+
 /* --- PRIVATE MACROS ------------------------------------------------------- */
 
 /**
@@ -245,24 +261,92 @@
 #    define WS2812_WHITE_BIT(led, bit) WS2812_BIT((led), 3, (bit))
 #endif
 
+/**
+ * @brief   Duty cycle of a bit of a nibble
+ *
+ * @param[in] nibble:               The nibble [0, 15]
+ * @param[in] bit:                  The bit number [0, 3]
+ *
+ * @return                          The duty cycle
+ */
+#define WS2812_NIBBLE_BIT(nibble, bit) ((((nibble) >> (bit)) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0)
+
+/**
+ * @brief   Duty cycles of the bits of a nibble, in the order they are sent
+ *
+ * @param[in] nibble:               The nibble [0, 15]
+ */
+#define WS2812_NIBBLE(nibble) \
+    { WS2812_NIBBLE_BIT((nibble), 3), WS2812_NIBBLE_BIT((nibble), 2), WS2812_NIBBLE_BIT((nibble), 1), WS2812_NIBBLE_BIT((nibble), 0) }
+
 /* --- PRIVATE VARIABLES ---------------------------------------------------- */
 
-static uint32_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+/**
+ * @brief   Buffers for a frame
+ *
+ * With WS2812_PWM_DOUBLE_BUFFER the DMA keeps sending the front buffer while the next frame is encoded into the other
+ * one, and switches over at the end of a frame.
+ */
+static uint32_t ws2812_frame_buffer[WS2812_BUFFER_N][WS2812_BIT_N + 1];
 
-/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
-/*
- * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
-the memory (while the DMA is reading/writing from/to a buffer, the application can
-write/read to/from the other buffer).
+static LED_TYPE         ws2812_encoded[WS2812_BUFFER_N][RGBLED_NUM]; /**< Colors each buffer currently holds */
+static volatile uint8_t ws2812_front;                                 /**< Buffer read by the DMA */
+static uint8_t          ws2812_back;                                  /**< Buffer written by ws2812_setleds() */
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+static volatile bool ws2812_swap_pending; /**< The back buffer holds a new frame */
+#endif
+
+/**
+ * @brief   Duty cycles for all 16 nibbles, so a byte is encoded with two copies and no branches
  */
+static const uint32_t ws2812_nibble_table[16][4] = {
+    WS2812_NIBBLE(0x0), WS2812_NIBBLE(0x1), WS2812_NIBBLE(0x2), WS2812_NIBBLE(0x3), WS2812_NIBBLE(0x4), WS2812_NIBBLE(0x5), WS2812_NIBBLE(0x6), WS2812_NIBBLE(0x7),
+    WS2812_NIBBLE(0x8), WS2812_NIBBLE(0x9), WS2812_NIBBLE(0xA), WS2812_NIBBLE(0xB), WS2812_NIBBLE(0xC), WS2812_NIBBLE(0xD), WS2812_NIBBLE(0xE), WS2812_NIBBLE(0xF),
+};
+
+/* --- PRIVATE FUNCTIONS ---------------------------------------------------- */
+
+/**
+ * @brief   Encode a color byte into the duty cycles of its 8 bits
+ *
+ * @param[out] bits:                The first bit of the byte in a frame buffer
+ * @param[in] value:                The color byte
+ */
+static inline void ws2812_write_byte(uint32_t* bits, uint8_t value) {
+    memcpy(&bits[0], ws2812_nibble_table[value >> 4], sizeof(ws2812_nibble_table[0]));
+    memcpy(&bits[4], ws2812_nibble_table[value & 0x0F], sizeof(ws2812_nibble_table[0]));
+}
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+/**
+ * @brief   Switch the DMA over to a new frame once the current one is complete
+ */
+static void ws2812_dma_isr(void* param, uint32_t flags) {
+    (void)param;
+    if ((flags & STM32_DMA_ISR_TCIF) && ws2812_swap_pending) {
+        ws2812_swap_pending = false;
+        ws2812_front ^= 1;
+        // The memory address can only be changed on a disabled stream, which also clears the interrupt enable
+        dmaStreamDisable(WS2812_DMA_STREAM);
+        dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer[ws2812_front]);
+        dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+        dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
+        dmaStreamEnable(WS2812_DMA_STREAM);
+    }
+}
+#endif
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 
 void ws2812_init(void) {
-    // Initialize led frame buffer
+    // Initialize led frame buffers
     uint32_t i;
-    for (i = 0; i < WS2812_COLOR_BIT_N; i++)
-        ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
-    for (i = 0; i < WS2812_RESET_BIT_N; i++)
-        ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    for (uint8_t buffer = 0; buffer < WS2812_BUFFER_N; buffer++) {
+        for (i = 0; i < WS2812_COLOR_BIT_N; i++)
+            ws2812_frame_buffer[buffer][i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
+        for (i = 0; i < WS2812_RESET_BIT_N; i++)
+            ws2812_frame_buffer[buffer][i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    }
 
     palSetLineMode(RGB_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -284,12 +368,15 @@ void ws2812_init(void) {
 
     // Configure DMA
     // dmaInit(); // Joe added this
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_isr, NULL);
+#else
     dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
+#endif
     dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer[ws2812_front]);
     dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
-    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
-    // M2P: Memory 2 Periph; PL: Priority Level
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
 
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
     // If the MCU has a DMAMUX we need to assign the correct resource
@@ -309,22 +396,17 @@ void ws2812_init(void) {
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
     // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-    }
+    uint32_t* frame = ws2812_frame_buffer[ws2812_back];
+    ws2812_write_byte(&frame[WS2812_RED_BIT(led_number, 7)], r);
+    ws2812_write_byte(&frame[WS2812_GREEN_BIT(led_number, 7)], g);
+    ws2812_write_byte(&frame[WS2812_BLUE_BIT(led_number, 7)], b);
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
     // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_write_led(led_number, r, g, b);
 #ifdef RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_write_byte(&ws2812_frame_buffer[ws2812_back][WS2812_WHITE_BIT(led_number, 7)], w);
 #endif
-    }
 }
 
 // Setleds for standard RGB
@@ -335,11 +417,30 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    // A frame that is still waiting for the switch has not been sent yet, so it can simply be overwritten
+    chSysLock();
+    ws2812_swap_pending = false;
+    ws2812_back         = ws2812_front ^ 1;
+    chSysUnlock();
+#endif
+
+    // Only re-encode the LEDs that differ from what the buffer already holds
     for (uint16_t i = 0; i < leds; i++) {
+        if (memcmp(&ledarray[i], &ws2812_encoded[ws2812_back][i], sizeof(LED_TYPE)) == 0) {
+            continue;
+        }
+        ws2812_encoded[ws2812_back][i] = ledarray[i];
 #ifdef RGBW
         ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
 #else
         ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
 #endif
     }
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    chSysLock();
+    ws2812_swap_pending = true;
+    chSysUnlock();
+#endif
 }
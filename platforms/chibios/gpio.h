@@ -36,3 +36,24 @@ typedef ioline_t pin_t;
 #define readPin(pin) palReadLine(pin)
 
 #define togglePin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportmask_t port_data_t;
+
+#define readPort(pin) palReadPort(PAL_PORT(pin))
+#define getPinPort(pin) PAL_PORT(pin)
+#define getPinPad(pin) PAL_PAD(pin)
+
+/* Edge interrupts by pin, requires PAL_USE_CALLBACKS in halconf.h. */
+#define enablePinInterruptFalling(pin, callback)                \
+    do {                                                        \
+        palEnableLineEvent((pin), PAL_EVENT_MODE_FALLING_EDGE); \
+        palSetLineCallback((pin), (callback), NULL);            \
+    } while (0)
+#define enablePinInterruptBoth(pin, callback)                 \
+    do {                                                      \
+        palEnableLineEvent((pin), PAL_EVENT_MODE_BOTH_EDGES); \
+        palSetLineCallback((pin), (callback), NULL);          \
+    } while (0)
+#define disablePinInterrupt(pin) palDisableLineEvent(pin)
@@ -3,6 +3,7 @@
 #include "action.h"
 #include "util.h"
 #include "action_layer.h"
+#include "keymap.h"
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -10,6 +11,10 @@
 #    include "nodebug.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 /** \brief Default Layer State
  */
 layer_state_t default_layer_state = 0;
@@ -122,6 +127,10 @@ void layer_state_set(layer_state_t state) {
     layer_state = state;
     layer_debug();
     dprintln();
+#    ifdef TELEMETRY_ENABLE
+    uint32_t telemetry_state = state;
+    telemetry_record(TELEMETRY_LAYER, &telemetry_state, sizeof(telemetry_state));
+#    endif
 #    ifdef STRICT_LAYER_RELEASE
     clear_keyboard_but_mods(); // To avoid stuck keys
 #    else
@@ -290,15 +299,13 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
     layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
+            /* only KC_TRANSPARENT decodes to ACTION_TRANSPARENT, so the
+               action is only worked out once for the layer found */
+            if (keymap_key_to_keycode(i, key) != KC_TRANSPARENT) {
                 return i;
             }
         }
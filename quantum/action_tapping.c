@@ -6,14 +6,17 @@
 #include "keycode.h"
 #include "timer.h"
 
-#ifdef DEBUG_ACTION
-#    include "debug.h"
-#else
-#    include "nodebug.h"
-#endif
+#define TRACE_MODULE TAPPING
+#include "trace.h"
 
 #ifndef NO_ACTION_TAPPING
 
+// Formats and arguments of trace statements for key events and records
+#    define TRACE_EVENT_FORMAT "%04X%c(%u)"
+#    define TRACE_EVENT_ARGS(e) ((e).key.row << 8 | (e).key.col), ((e).pressed ? 'd' : 'u'), (e).time
+#    define TRACE_RECORD_FORMAT TRACE_EVENT_FORMAT ":%u%c"
+#    define TRACE_RECORD_ARGS(r) TRACE_EVENT_ARGS((r).event), (r).tap.count, ((r).tap.interrupted ? '-' : ' ')
+
 #    define IS_TAPPING() !IS_NOEVENT(tapping_key.event)
 #    define IS_TAPPING_PRESSED() (IS_TAPPING() && tapping_key.event.pressed)
 #    define IS_TAPPING_RELEASED() (IS_TAPPING() && !tapping_key.event.pressed)
@@ -79,14 +82,12 @@ static void debug_waiting_buffer(void);
 void action_tapping_process(keyrecord_t record) {
     if (process_tapping(&record)) {
         if (!IS_NOEVENT(record.event)) {
-            debug("processed: ");
-            debug_record(record);
-            debug("\n");
+            trace_debug("processed: " TRACE_RECORD_FORMAT, TRACE_RECORD_ARGS(record));
         }
     } else {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
-            debug("OVERFLOW: CLEAR ALL STATES\n");
+            trace_debug("OVERFLOW: CLEAR ALL STATES");
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){};
@@ -95,22 +96,15 @@ void action_tapping_process(keyrecord_t record) {
 
     // process waiting_buffer
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
-        debug("---- action_exec: process waiting_buffer -----\n");
+        trace_debug("---- action_exec: process waiting_buffer -----");
     }
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            debug("processed: waiting_buffer[");
-            debug_dec(waiting_buffer_tail);
-            debug("] = ");
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            debug("\n\n");
+            trace_debug("processed: waiting_buffer " TRACE_RECORD_FORMAT, TRACE_RECORD_ARGS(waiting_buffer[waiting_buffer_tail]));
         } else {
             break;
         }
     }
-    if (!IS_NOEVENT(record.event)) {
-        debug("\n");
-    }
 }
 
 /** \brief Tapping
@@ -145,7 +139,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     retroshift_swap_times();
 #    endif
                     // first tap!
-                    debug("Tapping: First tap(0->1).\n");
+                    trace_debug("Tapping: First tap(0->1).");
                     tapping_key.tap.count = 1;
                     debug_tapping_key();
                     process_record(&tapping_key);
@@ -223,7 +217,7 @@ bool process_tapping(keyrecord_t *keyp) {
 #        endif
                 ) {
                     // clang-format on
-                    debug("Tapping: End. No tap. Interfered by typing key\n");
+                    trace_debug("Tapping: End. No tap. Interfered by typing key");
                     process_record(&tapping_key);
                     tapping_key = (keyrecord_t){};
                     debug_tapping_key();
@@ -251,7 +245,7 @@ bool process_tapping(keyrecord_t *keyp) {
                             break;
                     }
                     // Release of key should be process immediately.
-                    debug("Tapping: release event of a key pressed before tapping\n");
+                    trace_debug("Tapping: release event of a key pressed before tapping");
                     process_record(keyp);
                     return true;
                 } else {
@@ -263,7 +257,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         if (get_hold_on_other_key_press(tapping_keycode, &tapping_key))
 #        endif
                         {
-                            debug("Tapping: End. No tap. Interfered by pressed key\n");
+                            trace_debug("Tapping: End. No tap. Interfered by pressed key");
                             process_record(&tapping_key);
                             tapping_key = (keyrecord_t){};
                             debug_tapping_key();
@@ -279,17 +273,15 @@ bool process_tapping(keyrecord_t *keyp) {
             // tap_count > 0
             else {
                 if (IS_TAPPING_RECORD(keyp) && !event.pressed) {
-                    debug("Tapping: Tap release(");
-                    debug_dec(tapping_key.tap.count);
-                    debug(")\n");
+                    trace_debug("Tapping: Tap release(%u)", tapping_key.tap.count);
                     keyp->tap = tapping_key.tap;
                     process_record(keyp);
                     tapping_key = *keyp;
                     debug_tapping_key();
                     return true;
-                } else if (is_tap_record(keyp) && event.pressed) {
+                } else if (event.pressed && is_tap_record(keyp)) {
                     if (tapping_key.tap.count > 1) {
-                        debug("Tapping: Start new tap with releasing last tap(>1).\n");
+                        trace_debug("Tapping: Start new tap with releasing last tap(>1).");
                         // unregister key
                         process_record(&(keyrecord_t){
                             .tap           = tapping_key.tap,
@@ -301,7 +293,7 @@ bool process_tapping(keyrecord_t *keyp) {
 #    endif
                         });
                     } else {
-                        debug("Tapping: Start while last tap(1).\n");
+                        trace_debug("Tapping: Start while last tap(1).");
                     }
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
@@ -309,7 +301,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     return true;
                 } else {
                     if (!IS_NOEVENT(event)) {
-                        debug("Tapping: key event while last tap(>0).\n");
+                        trace_debug("Tapping: key event while last tap(>0).");
                     }
                     process_record(keyp);
                     return true;
@@ -319,23 +311,21 @@ bool process_tapping(keyrecord_t *keyp) {
         // after TAPPING_TERM
         else {
             if (tapping_key.tap.count == 0) {
-                debug("Tapping: End. Timeout. Not tap(0): ");
-                debug_event(event);
-                debug("\n");
+                trace_debug("Tapping: End. Timeout. Not tap(0): " TRACE_EVENT_FORMAT, TRACE_EVENT_ARGS(event));
                 process_record(&tapping_key);
                 tapping_key = (keyrecord_t){};
                 debug_tapping_key();
                 return false;
             } else {
                 if (IS_TAPPING_RECORD(keyp) && !event.pressed) {
-                    debug("Tapping: End. last timeout tap release(>0).");
+                    trace_debug("Tapping: End. last timeout tap release(>0).");
                     keyp->tap = tapping_key.tap;
                     process_record(keyp);
                     tapping_key = (keyrecord_t){};
                     return true;
-                } else if (is_tap_record(keyp) && event.pressed) {
+                } else if (event.pressed && is_tap_record(keyp)) {
                     if (tapping_key.tap.count > 1) {
-                        debug("Tapping: Start new tap with releasing last timeout tap(>1).\n");
+                        trace_debug("Tapping: Start new tap with releasing last timeout tap(>1).");
                         // unregister key
                         process_record(&(keyrecord_t){
                             .tap           = tapping_key.tap,
@@ -347,7 +337,7 @@ bool process_tapping(keyrecord_t *keyp) {
 #    endif
                         });
                     } else {
-                        debug("Tapping: Start while last timeout tap(1).\n");
+                        trace_debug("Tapping: Start while last timeout tap(1).");
                     }
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
@@ -355,7 +345,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     return true;
                 } else {
                     if (!IS_NOEVENT(event)) {
-                        debug("Tapping: key event while last timeout tap(>0).\n");
+                        trace_debug("Tapping: key event while last timeout tap(>0).");
                     }
                     process_record(keyp);
                     return true;
@@ -387,9 +377,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         // sequential tap.
                         keyp->tap = tapping_key.tap;
                         if (keyp->tap.count < 15) keyp->tap.count += 1;
-                        debug("Tapping: Tap press(");
-                        debug_dec(keyp->tap.count);
-                        debug(")\n");
+                        trace_debug("Tapping: Tap press(%u)", keyp->tap.count);
                         process_record(keyp);
                         tapping_key = *keyp;
                         debug_tapping_key();
@@ -401,7 +389,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     return true;
                 } else if (is_tap_record(keyp)) {
                     // Sequential tap can be interfered with other tap key.
-                    debug("Tapping: Start with interfering other tap.\n");
+                    trace_debug("Tapping: Start with interfering other tap.");
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
@@ -414,16 +402,14 @@ bool process_tapping(keyrecord_t *keyp) {
                     return true;
                 }
             } else {
-                if (!IS_NOEVENT(event)) debug("Tapping: other key just after tap.\n");
+                if (!IS_NOEVENT(event)) trace_debug("Tapping: other key just after tap.");
                 process_record(keyp);
                 return true;
             }
         } else {
             // FIX: process_action here?
             // timeout. no sequential tap.
-            debug("Tapping: End(Timeout after releasing last tap): ");
-            debug_event(event);
-            debug("\n");
+            trace_debug("Tapping: End(Timeout after releasing last tap): " TRACE_EVENT_FORMAT, TRACE_EVENT_ARGS(event));
             tapping_key = (keyrecord_t){};
             debug_tapping_key();
             return false;
@@ -432,7 +418,7 @@ bool process_tapping(keyrecord_t *keyp) {
     // not tapping state
     else {
         if (event.pressed && is_tap_record(keyp)) {
-            debug("Tapping: Start(Press tap key).\n");
+            trace_debug("Tapping: Start(Press tap key).");
             tapping_key = *keyp;
             process_record_tap_hint(&tapping_key);
             waiting_buffer_scan_tap();
@@ -455,14 +441,14 @@ bool waiting_buffer_enq(keyrecord_t record) {
     }
 
     if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
-        debug("waiting_buffer_enq: Over flow.\n");
+        trace_debug("waiting_buffer_enq: Over flow.");
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
-    debug("waiting_buffer_enq: ");
+    trace_debug("waiting_buffer_enq:");
     debug_waiting_buffer();
     return true;
 }
@@ -516,9 +502,7 @@ void waiting_buffer_scan_tap(void) {
             waiting_buffer[i].tap.count = 1;
             process_record(&tapping_key);
 
-            debug("waiting_buffer_scan_tap: found at [");
-            debug_dec(i);
-            debug("]\n");
+            trace_debug("waiting_buffer_scan_tap: found at [%u]", i);
             debug_waiting_buffer();
             return;
         }
@@ -530,9 +514,7 @@ void waiting_buffer_scan_tap(void) {
  * FIXME: Needs docs
  */
 static void debug_tapping_key(void) {
-    debug("TAPPING_KEY=");
-    debug_record(tapping_key);
-    debug("\n");
+    trace_debug("TAPPING_KEY=" TRACE_RECORD_FORMAT, TRACE_RECORD_ARGS(tapping_key));
 }
 
 /** \brief Waiting buffer debug print
@@ -540,15 +522,9 @@ static void debug_tapping_key(void) {
  * FIXME: Needs docs
  */
 static void debug_waiting_buffer(void) {
-    debug("{ ");
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        debug("[");
-        debug_dec(i);
-        debug("]=");
-        debug_record(waiting_buffer[i]);
-        debug(" ");
+        trace_debug("  " TRACE_RECORD_FORMAT, TRACE_RECORD_ARGS(waiting_buffer[i]));
     }
-    debug("}\n");
 }
 
 #endif
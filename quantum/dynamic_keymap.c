@@ -14,9 +14,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "keymap.h" // to get keymaps[][][]
+#include <string.h>
+#include "keymap.h" // to get keymap_flash_keycode()
 #include "eeprom.h"
-#include "progmem.h" // to read default from flash
 #include "quantum.h" // for send_string()
 #include "dynamic_keymap.h"
 #include "via.h" // for default VIA_EEPROM_ADDR_END
@@ -79,6 +79,40 @@
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+// Keycodes read from EEPROM are kept in a small direct mapped cache, as
+// every key event looks up its position on each active layer and some
+// EEPROM drivers, such as external I2C ones, are slow to read.
+// Must be a power of two, 0 disables the cache.
+#ifndef DYNAMIC_KEYMAP_CACHE_SIZE
+#    define DYNAMIC_KEYMAP_CACHE_SIZE 8
+#endif
+
+#if DYNAMIC_KEYMAP_CACHE_SIZE > 0
+_Static_assert((DYNAMIC_KEYMAP_CACHE_SIZE & (DYNAMIC_KEYMAP_CACHE_SIZE - 1)) == 0, "DYNAMIC_KEYMAP_CACHE_SIZE must be a power of two");
+
+typedef struct {
+    uint16_t key; // index of the key on all layers plus one, 0 when unused
+    uint16_t keycode;
+} dynamic_keymap_cache_entry_t;
+
+static dynamic_keymap_cache_entry_t dynamic_keymap_cache[DYNAMIC_KEYMAP_CACHE_SIZE];
+
+static inline uint16_t dynamic_keymap_cache_key(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS + row) * MATRIX_COLS + column + 1;
+}
+
+static inline dynamic_keymap_cache_entry_t *dynamic_keymap_cache_entry(uint8_t layer, uint8_t row, uint8_t column) {
+    // adding the layer keeps the layers of a key, looked up together, apart
+    return &dynamic_keymap_cache[(row * MATRIX_COLS + column + layer) & (DYNAMIC_KEYMAP_CACHE_SIZE - 1)];
+}
+
+static void dynamic_keymap_cache_clear(void) {
+    memset(dynamic_keymap_cache, 0, sizeof(dynamic_keymap_cache));
+}
+#else
+static inline void dynamic_keymap_cache_clear(void) {}
+#endif
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -89,10 +123,21 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+#if DYNAMIC_KEYMAP_CACHE_SIZE > 0
+    uint16_t                      key   = dynamic_keymap_cache_key(layer, row, column);
+    dynamic_keymap_cache_entry_t *entry = dynamic_keymap_cache_entry(layer, row, column);
+    if (entry->key == key) {
+        return entry->keycode;
+    }
+#endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
+#if DYNAMIC_KEYMAP_CACHE_SIZE > 0
+    entry->key     = key;
+    entry->keycode = keycode;
+#endif
     return keycode;
 }
 
@@ -101,6 +146,12 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#if DYNAMIC_KEYMAP_CACHE_SIZE > 0
+    dynamic_keymap_cache_entry_t *entry = dynamic_keymap_cache_entry(layer, row, column);
+    if (entry->key == dynamic_keymap_cache_key(layer, row, column)) {
+        entry->keycode = keycode;
+    }
+#endif
 }
 
 void dynamic_keymap_reset(void) {
@@ -110,7 +161,7 @@ void dynamic_keymap_reset(void) {
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
-                dynamic_keymap_set_keycode(layer, row, column, pgm_read_word(&keymaps[layer][row][column]));
+                dynamic_keymap_set_keycode(layer, row, column, keymap_flash_keycode(layer, row, column));
             }
         }
     }
@@ -142,6 +193,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+    dynamic_keymap_cache_clear();
 }
 
 // This overrides the one in quantum/keymap_common.c
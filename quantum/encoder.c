@@ -50,13 +50,39 @@ static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1,
 static uint8_t encoder_state[NUMBER_OF_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUMBER_OF_ENCODERS] = {0};
 
+#ifdef ENCODER_READ_ON_INTERRUPT
+#    ifndef enablePinInterruptBoth
+#        error ENCODER_READ_ON_INTERRUPT is not supported on this platform
+#    endif
+/* Free running detent counts, written only by the pin interrupt. encoder_read() takes the difference to the count it
+ * saw last, so no locking is needed and up to 127 detents can pile up between two reads. */
+static volatile uint8_t encoder_detents[NUMBER_OF_ENCODERS]      = {0};
+static uint8_t          encoder_detents_read[NUMBER_OF_ENCODERS] = {0};
+
+static void encoder_interrupt(void *arg);
+#endif
+
+#ifdef ENCODER_ACCEL_CURVE
+#    ifndef ENCODER_ACCEL_STEP_MS
+#        define ENCODER_ACCEL_STEP_MS 10
+#    endif
+// steps per detent for each ENCODER_ACCEL_STEP_MS of time between detents, fastest first
+static const uint8_t PROGMEM encoder_accel_curve[] = ENCODER_ACCEL_CURVE;
+#    define ENCODER_ACCEL_CURVE_LENGTH (sizeof(encoder_accel_curve) / sizeof(encoder_accel_curve[0]))
+#endif
+
 #ifdef SPLIT_KEYBOARD
 // right half encoders come over as second set of encoders
 static uint8_t encoder_value[NUMBER_OF_ENCODERS * 2] = {0};
 // row offsets for each hand
 static uint8_t thisHand, thatHand;
 #else
-static uint8_t encoder_value[NUMBER_OF_ENCODERS] = {0};
+static uint8_t       encoder_value[NUMBER_OF_ENCODERS] = {0};
+static const uint8_t thisHand                          = 0;
+#endif
+
+#ifdef ENCODER_ACCEL_CURVE
+static uint32_t encoder_last_detent[sizeof(encoder_value)];
 #endif
 
 __attribute__((weak)) void encoder_wait_pullup_charge(void) {
@@ -71,21 +97,31 @@ __attribute__((weak)) bool encoder_update_kb(uint8_t index, bool clockwise) {
     return encoder_update_user(index, clockwise);
 }
 
+__attribute__((weak)) bool encoder_update_steps_user(uint8_t index, bool clockwise, uint8_t steps) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps) {
+    return encoder_update_steps_user(index, clockwise, steps);
+}
+
 void encoder_init(void) {
 #if defined(SPLIT_KEYBOARD) && defined(ENCODERS_PAD_A_RIGHT) && defined(ENCODERS_PAD_B_RIGHT)
-    if (!isLeftHand) {
-        const pin_t encoders_pad_a_right[] = ENCODERS_PAD_A_RIGHT;
-        const pin_t encoders_pad_b_right[] = ENCODERS_PAD_B_RIGHT;
-#    if defined(ENCODER_RESOLUTIONS_RIGHT)
-        const uint8_t encoder_resolutions_right[] = ENCODER_RESOLUTIONS_RIGHT;
+    // Both halves are picked from the configuration, so initialising one does not lose the pads of the other
+    const pin_t encoders_pad_a_left[]  = ENCODERS_PAD_A;
+    const pin_t encoders_pad_b_left[]  = ENCODERS_PAD_B;
+    const pin_t encoders_pad_a_right[] = ENCODERS_PAD_A_RIGHT;
+    const pin_t encoders_pad_b_right[] = ENCODERS_PAD_B_RIGHT;
+#    if defined(ENCODER_RESOLUTIONS) && defined(ENCODER_RESOLUTIONS_RIGHT)
+    const uint8_t encoder_resolutions_left[]  = ENCODER_RESOLUTIONS;
+    const uint8_t encoder_resolutions_right[] = ENCODER_RESOLUTIONS_RIGHT;
 #    endif
-        for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
-            encoders_pad_a[i] = encoders_pad_a_right[i];
-            encoders_pad_b[i] = encoders_pad_b_right[i];
-#    if defined(ENCODER_RESOLUTIONS_RIGHT)
-            encoder_resolutions[i] = encoder_resolutions_right[i];
+    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        encoders_pad_a[i] = isLeftHand ? encoders_pad_a_left[i] : encoders_pad_a_right[i];
+        encoders_pad_b[i] = isLeftHand ? encoders_pad_b_left[i] : encoders_pad_b_right[i];
+#    if defined(ENCODER_RESOLUTIONS) && defined(ENCODER_RESOLUTIONS_RIGHT)
+        encoder_resolutions[i] = isLeftHand ? encoder_resolutions_left[i] : encoder_resolutions_right[i];
 #    endif
-        }
     }
 #endif
 
@@ -97,6 +133,20 @@ void encoder_init(void) {
     for (int i = 0; i < NUMBER_OF_ENCODERS; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+#ifdef ENCODER_READ_ON_INTERRUPT
+    for (int i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        encoder_detents_read[i] = encoder_detents[i];
+        enablePinInterruptBoth(encoders_pad_a[i], encoder_interrupt);
+        enablePinInterruptBoth(encoders_pad_b[i], encoder_interrupt);
+    }
+#endif
+
+#ifdef ENCODER_ACCEL_CURVE
+    // start out slow, so the first detent is never accelerated
+    for (uint8_t i = 0; i < sizeof(encoder_value); i++) {
+        encoder_last_detent[i] = timer_read32() - ENCODER_ACCEL_STEP_MS * ENCODER_ACCEL_CURVE_LENGTH;
+    }
+#endif
 
 #ifdef SPLIT_KEYBOARD
     thisHand = isLeftHand ? 0 : NUMBER_OF_ENCODERS;
@@ -104,9 +154,9 @@ void encoder_init(void) {
 #endif
 }
 
-static bool encoder_update(uint8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
+/* Decodes the last two samples of an encoder's pads, returns 1 or -1 when they complete a detent */
+static int8_t encoder_decode(uint8_t i, uint8_t state) {
+    int8_t detent = 0;
 
 #ifdef ENCODER_RESOLUTIONS
     uint8_t resolution = encoder_resolutions[i];
@@ -114,19 +164,12 @@ static bool encoder_update(uint8_t index, uint8_t state) {
     uint8_t resolution = ENCODER_RESOLUTION;
 #endif
 
-#ifdef SPLIT_KEYBOARD
-    index += thisHand;
-#endif
     encoder_pulses[i] += encoder_LUT[state & 0xF];
     if (encoder_pulses[i] >= resolution) {
-        encoder_value[index]++;
-        changed = true;
-        encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
+        detent = 1;
     }
     if (encoder_pulses[i] <= -resolution) { // direction is arbitrary here, but this clockwise
-        encoder_value[index]--;
-        changed = true;
-        encoder_update_kb(index, ENCODER_CLOCKWISE);
+        detent = -1;
     }
     encoder_pulses[i] %= resolution;
 #ifdef ENCODER_DEFAULT_POS
@@ -134,18 +177,84 @@ static bool encoder_update(uint8_t index, uint8_t state) {
         encoder_pulses[i] = 0;
     }
 #endif
-    return changed;
+    return detent;
+}
+
+#ifdef ENCODER_ACCEL_CURVE
+/* Looks up how many steps each detent is worth at the speed the encoder is turning */
+static uint8_t encoder_accel_gain(uint8_t index, uint8_t detents) {
+    uint32_t interval = timer_elapsed32(encoder_last_detent[index]) / detents;
+    uint32_t bucket   = interval / ENCODER_ACCEL_STEP_MS;
+
+    encoder_last_detent[index] = timer_read32();
+    if (bucket >= ENCODER_ACCEL_CURVE_LENGTH) {
+        bucket = ENCODER_ACCEL_CURVE_LENGTH - 1;
+    }
+    return pgm_read_byte(&encoder_accel_curve[bucket]);
+}
+#endif
+
+/* Delivers all detents an encoder moved since the last scan as one batch of steps. index includes the hand offset. */
+static bool encoder_update(uint8_t index, int8_t detents) {
+    if (detents == 0) {
+        return false;
+    }
+
+    encoder_value[index] += detents;
+
+    bool     clockwise = detents < 0 ? ENCODER_CLOCKWISE : ENCODER_COUNTER_CLOCKWISE;
+    uint16_t steps     = detents < 0 ? -detents : detents;
+#ifdef ENCODER_ACCEL_CURVE
+    steps *= encoder_accel_gain(index, steps);
+#endif
+    if (steps > UINT8_MAX) {
+        steps = UINT8_MAX;
+    }
+
+    // keymaps that do not handle the batch keep getting one call, and usually one report, per step
+    if (encoder_update_steps_kb(index, clockwise, steps)) {
+        while (steps--) {
+            encoder_update_kb(index, clockwise);
+        }
+    }
+    return true;
+}
+
+#ifdef ENCODER_READ_ON_INTERRUPT
+/* Runs on every edge of any pad, so only the encoders whose pads changed are decoded */
+static void encoder_interrupt(void *arg) {
+    (void)arg;
+    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        uint8_t pads = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
+        if (pads == (encoder_state[i] & 0x3)) {
+            continue;
+        }
+        encoder_state[i] = (encoder_state[i] << 2) | pads;
+        encoder_detents[i] += encoder_decode(i, encoder_state[i]);
+    }
 }
 
+bool encoder_read(void) {
+    bool changed = false;
+    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        uint8_t detents         = encoder_detents[i];
+        int8_t  delta           = detents - encoder_detents_read[i];
+        encoder_detents_read[i] = detents;
+        changed |= encoder_update(i + thisHand, delta);
+    }
+    return changed;
+}
+#else
 bool encoder_read(void) {
     bool changed = false;
     for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
         encoder_state[i] <<= 2;
         encoder_state[i] |= (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
-        changed |= encoder_update(i, encoder_state[i]);
+        changed |= encoder_update(i + thisHand, encoder_decode(i, encoder_state[i]));
     }
     return changed;
 }
+#endif
 
 #ifdef SPLIT_KEYBOARD
 void last_encoder_activity_trigger(void);
@@ -158,19 +267,7 @@ void encoder_update_raw(uint8_t* slave_state) {
     bool changed = false;
     for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
         uint8_t index = i + thatHand;
-        int8_t  delta = slave_state[i] - encoder_value[index];
-        while (delta > 0) {
-            delta--;
-            encoder_value[index]++;
-            changed = true;
-            encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-        }
-        while (delta < 0) {
-            delta++;
-            encoder_value[index]--;
-            changed = true;
-            encoder_update_kb(index, ENCODER_CLOCKWISE);
-        }
+        changed |= encoder_update(index, (int8_t)(slave_state[i] - encoder_value[index]));
     }
 
     // Update the last encoder input time -- handled external to encoder_read() when we're running a split
@@ -24,6 +24,8 @@ bool encoder_read(void);
 
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
+bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps);
+bool encoder_update_steps_user(uint8_t index, bool clockwise, uint8_t steps);
 
 #ifdef SPLIT_KEYBOARD
 void encoder_state_raw(uint8_t* slave_state);
@@ -0,0 +1,120 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void advance_time(uint32_t ms);
+}
+
+struct batch {
+    int8_t  index;
+    bool    clockwise;
+    uint8_t steps;
+};
+
+uint8_t uidx = 0;
+uint8_t bidx = 0;
+batch   batches[32];
+bool    handle_batches = false;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    uidx++;
+    return true;
+}
+
+bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps) {
+    batches[bidx % 32] = {index, clockwise, steps};
+    bidx++;
+    return !handle_batches;
+}
+
+/* Turns the encoder by one detent, reading it after every edge */
+void turn(bool clockwise) {
+    pin_t first = clockwise ? 0 : 1, second = clockwise ? 1 : 0;
+    setPin(first, false);
+    encoder_read();
+    setPin(second, false);
+    encoder_read();
+    setPin(first, true);
+    encoder_read();
+    setPin(second, true);
+    encoder_read();
+}
+
+class EncoderAccelTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        uidx = bidx    = 0;
+        handle_batches = false;
+        advance_time(1000);
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderAccelTest, TestSlowTurnsAreNotAccelerated) {
+    for (int i = 0; i < 3; i++) {
+        advance_time(50);
+        turn(true);
+    }
+    EXPECT_EQ(bidx, 3);
+    EXPECT_EQ(uidx, 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(batches[i].steps, 1);
+        EXPECT_EQ(batches[i].clockwise, true);
+    }
+}
+
+TEST_F(EncoderAccelTest, TestFirstDetentIsNotAccelerated) {
+    turn(true);
+    EXPECT_EQ(bidx, 1);
+    EXPECT_EQ(batches[0].steps, 1);
+}
+
+TEST_F(EncoderAccelTest, TestFastTurnsFollowTheCurve) {
+    advance_time(50);
+    turn(false);
+    advance_time(15);
+    turn(false);
+    advance_time(5);
+    turn(false);
+
+    EXPECT_EQ(bidx, 3);
+    EXPECT_EQ(batches[0].steps, 1);
+    EXPECT_EQ(batches[1].steps, 2);
+    EXPECT_EQ(batches[2].steps, 4);
+    EXPECT_EQ(batches[2].clockwise, false);
+    EXPECT_EQ(uidx, 7);
+}
+
+TEST_F(EncoderAccelTest, TestHandledBatchSkipsSingleSteps) {
+    handle_batches = true;
+    advance_time(50);
+    turn(true);
+    advance_time(5);
+    turn(true);
+
+    EXPECT_EQ(bidx, 2);
+    EXPECT_EQ(batches[1].steps, 4);
+    EXPECT_EQ(uidx, 0);
+}
@@ -0,0 +1,125 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t uidx = 0;
+update  updates[32];
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates[uidx % 32] = {index, clockwise};
+    uidx++;
+    return true;
+}
+
+uint8_t bidx = 0;
+uint8_t last_steps;
+
+bool encoder_update_steps_kb(uint8_t index, bool clockwise, uint8_t steps) {
+    last_steps = steps;
+    bidx++;
+    return true;
+}
+
+/* Turns the encoder by whole detents without calling encoder_read(), like a spin during a long keyboard_task(). */
+void spin(int detents) {
+    for (; detents > 0; detents--) {
+        setPin(0, false);
+        setPin(1, false);
+        setPin(0, true);
+        setPin(1, true);
+    }
+    for (; detents < 0; detents++) {
+        setPin(1, false);
+        setPin(0, false);
+        setPin(1, true);
+        setPin(0, true);
+    }
+}
+
+class EncoderTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        uidx = bidx = 0;
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderTest, TestNothingWithoutEdges) {
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(uidx, 0);
+}
+
+TEST_F(EncoderTest, TestOneClockwise) {
+    spin(1);
+    EXPECT_EQ(uidx, 0);
+
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(uidx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderTest, TestFastSpinIsNotLost) {
+    spin(20);
+
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(bidx, 1);
+    EXPECT_EQ(last_steps, 20);
+    EXPECT_EQ(uidx, 20);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(updates[i].clockwise, true);
+    }
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(uidx, 20);
+}
+
+TEST_F(EncoderTest, TestReversalBetweenReads) {
+    spin(3);
+    spin(-5);
+
+    encoder_read();
+    EXPECT_EQ(uidx, 2);
+    EXPECT_EQ(updates[0].clockwise, false);
+    EXPECT_EQ(updates[1].clockwise, false);
+}
+
+TEST_F(EncoderTest, TestPartialDetentCarriesOver) {
+    setPin(0, false);
+    setPin(1, false);
+    setPin(0, true);
+    encoder_read();
+    EXPECT_EQ(uidx, 0);
+
+    setPin(1, true);
+    encoder_read();
+    EXPECT_EQ(uidx, 1);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
@@ -14,11 +14,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stddef.h>
 #include "mock.h"
 
 bool pins[32]           = {0};
 bool pinIsInputHigh[32] = {0};
 
+static void (*pinCallbacks[32])(void*) = {0};
+
 uint8_t mockSetPinInputHigh(pin_t pin) {
     // dprintf("Setting pin %d input high.", pin);
     pins[pin]           = true;
@@ -30,7 +33,16 @@ bool mockReadPin(pin_t pin) {
     return pins[pin];
 }
 
+void mockEnablePinInterrupt(pin_t pin, void (*callback)(void*)) {
+    pinCallbacks[pin] = callback;
+}
+
 bool setPin(pin_t pin, bool val) {
-    pins[pin] = val;
+    bool changed = pins[pin] != val;
+    pins[pin]    = val;
+    // edges raise the pin interrupt, if one is enabled
+    if (changed && pinCallbacks[pin]) {
+        pinCallbacks[pin](NULL);
+    }
     return val;
 }
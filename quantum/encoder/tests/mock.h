@@ -32,9 +32,12 @@ extern bool pinIsInputHigh[];
 
 #define setPinInputHigh(pin) (mockSetPinInputHigh(pin))
 #define readPin(pin) (mockReadPin(pin))
+#define enablePinInterruptBoth(pin, callback) (mockEnablePinInterrupt(pin, callback))
 
 uint8_t mockSetPinInputHigh(pin_t pin);
 
 bool mockReadPin(pin_t pin);
 
+void mockEnablePinInterrupt(pin_t pin, void (*callback)(void*));
+
 bool setPin(pin_t pin, bool val);
@@ -30,10 +30,10 @@
 #define ENCODERS_PAD_B_RIGHT \
     { 3 }
 
-typedef uint8_t pin_t;
-extern bool     isLeftHand;
-void            encoder_state_raw(uint8_t* slave_state);
-void            encoder_update_raw(uint8_t* slave_state);
+typedef uint8_t      pin_t;
+extern volatile bool isLeftHand;
+void                 encoder_state_raw(uint8_t* slave_state);
+void                 encoder_update_raw(uint8_t* slave_state);
 
 extern bool pins[];
 extern bool pinIsInputHigh[];
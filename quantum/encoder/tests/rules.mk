@@ -1,13 +1,36 @@
 encoder_DEFS := -DENCODER_MOCK_SINGLE
+encoder_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
 
 encoder_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
 	$(QUANTUM_PATH)/encoder/tests/mock.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
 encoder_split_DEFS := -DENCODER_MOCK_SPLIT
+encoder_split_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split.h
+encoder_split_INC := $(QUANTUM_PATH)/split_common
 
 encoder_split_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests_split.cpp \
 	$(QUANTUM_PATH)/encoder.c
+
+encoder_interrupt_DEFS := -DENCODER_MOCK_SINGLE -DENCODER_READ_ON_INTERRUPT
+encoder_interrupt_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_interrupt_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_interrupt.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
+encoder_accel_DEFS := -DENCODER_MOCK_SINGLE
+encoder_accel_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_accel.h
+
+encoder_accel_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_accel.cpp \
+	$(QUANTUM_PATH)/encoder.c
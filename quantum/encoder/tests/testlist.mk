@@ -1,3 +1,5 @@
 TEST_LIST += \
 	encoder \
-	encoder_split
+	encoder_split \
+	encoder_interrupt \
+	encoder_accel
@@ -48,4 +48,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // translates key to keycode
 uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
+// reads a keycode of the keymap stored in flash
+uint16_t keymap_flash_keycode(uint8_t layer, uint8_t row, uint8_t col);
+
 extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+
+#ifdef SPARSE_KEYMAP_ENABLE
+#    include "matrix.h"
+
+// Sparse keymap generated by `qmk json2c --sparse` in place of keymaps[][][]
+// A set bit in the row mask of a layer means the key is stored, at the row
+// offset plus the number of set bits before it. Keys that are not stored are
+// KC_NO on layer 0 and KC_TRANSPARENT on the layers above it.
+extern const matrix_row_t sparse_keymap_masks[][MATRIX_ROWS];
+extern const uint16_t     sparse_keymap_offsets[][MATRIX_ROWS];
+extern const uint16_t     sparse_keymap_keycodes[];
+#endif
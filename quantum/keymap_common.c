@@ -31,6 +31,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "process_midi.h"
 #endif
 
+#ifdef SPARSE_KEYMAP_ENABLE
+#    include "bitwise.h"
+#    if (MATRIX_COLS <= 8)
+#        define pgm_read_matrix_row(address) pgm_read_byte(address)
+#        define bitpop_matrix_row(row) bitpop(row)
+#    elif (MATRIX_COLS <= 16)
+#        define pgm_read_matrix_row(address) pgm_read_word(address)
+#        define bitpop_matrix_row(row) bitpop16(row)
+#    elif (MATRIX_COLS <= 32)
+#        define pgm_read_matrix_row(address) pgm_read_dword(address)
+#        define bitpop_matrix_row(row) bitpop32(row)
+#    else
+#        error "SPARSE_KEYMAP_ENABLE supports at most 32 matrix columns"
+#    endif
+#endif
+
 extern keymap_config_t keymap_config;
 
 #include <inttypes.h>
@@ -148,6 +164,20 @@ action_t action_for_keycode(uint16_t keycode) {
 
 // translates key to keycode
 __attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keymap_flash_keycode(layer, key.row, key.col);
+}
+
+uint16_t keymap_flash_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+#ifdef SPARSE_KEYMAP_ENABLE
+    matrix_row_t mask = pgm_read_matrix_row(&sparse_keymap_masks[layer][row]);
+    matrix_row_t bit  = MATRIX_ROW_SHIFTER << col;
+
+    if (!(mask & bit)) {
+        return layer == 0 ? KC_NO : KC_TRANSPARENT;
+    }
+    return pgm_read_word(&sparse_keymap_keycodes[pgm_read_word(&sparse_keymap_offsets[layer][row]) + bitpop_matrix_row(mask & (bit - 1))]);
+#else
     // Read entire word (16bits)
-    return pgm_read_word(&keymaps[(layer)][(key.row)][(key.col)]);
+    return pgm_read_word(&keymaps[layer][row][col]);
+#endif
 }
@@ -0,0 +1,112 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Trace statements with compile time levels per module
+ *
+ * A source file picks its module before including this header:
+ *
+ *     #define TRACE_MODULE TAPPING
+ *     #include "trace.h"
+ *
+ *     trace_debug("tap count %u", count);
+ *
+ * Statements above the level of their module, TRACE_LEVEL_<module>, are removed
+ * by the compiler along with their format strings. With TELEMETRY_ENABLE the
+ * remaining ones only send the module, a hash of the file, the line and up to
+ * 5 arguments, which `qmk telemetry` formats from the source. Otherwise they
+ * are printed with dprintf() as before.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define TRACE_LEVEL_NONE 0
+#define TRACE_LEVEL_ERROR 1
+#define TRACE_LEVEL_WARN 2
+#define TRACE_LEVEL_INFO 3
+#define TRACE_LEVEL_DEBUG 4
+#define TRACE_LEVEL_VERBOSE 5
+
+// Default level of every module
+#ifndef TRACE_LEVEL
+#    define TRACE_LEVEL TRACE_LEVEL_NONE
+#endif
+
+// Module IDs group statements for their levels, keep them unique
+#define TRACE_MODULE_ID_TAPPING 0x01
+#define TRACE_MODULE_ID_KEYBOARD 0x80
+#define TRACE_MODULE_ID_USER 0x81
+
+#ifndef TRACE_LEVEL_TAPPING
+#    ifdef DEBUG_ACTION
+#        define TRACE_LEVEL_TAPPING TRACE_LEVEL_DEBUG
+#    else
+#        define TRACE_LEVEL_TAPPING TRACE_LEVEL
+#    endif
+#endif
+#ifndef TRACE_LEVEL_KEYBOARD
+#    define TRACE_LEVEL_KEYBOARD TRACE_LEVEL
+#endif
+#ifndef TRACE_LEVEL_USER
+#    define TRACE_LEVEL_USER TRACE_LEVEL
+#endif
+
+#ifndef TRACE_MODULE
+#    define TRACE_MODULE USER
+#endif
+
+#define TRACE_CAT_(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT_(a, b)
+#define TRACE_MODULE_LEVEL TRACE_CAT(TRACE_LEVEL_, TRACE_MODULE)
+#define TRACE_MODULE_ID TRACE_CAT(TRACE_MODULE_ID_, TRACE_MODULE)
+
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+
+#    define TRACE_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+#    define TRACE_NARGS(...) TRACE_NARGS_(_, ##__VA_ARGS__, TOO_MANY_ARGUMENTS, 5, 4, 3, 2, 1, 0)
+#    define TRACE_ARGS_0()
+#    define TRACE_ARGS_1(a) , (uint32_t)(a)
+#    define TRACE_ARGS_2(a, b) , (uint32_t)(a), (uint32_t)(b)
+#    define TRACE_ARGS_3(a, b, c) , (uint32_t)(a), (uint32_t)(b), (uint32_t)(c)
+#    define TRACE_ARGS_4(a, b, c, d) , (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d)
+#    define TRACE_ARGS_5(a, b, c, d, e) , (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d), (uint32_t)(e)
+
+// FNV-1a of the first 128 characters of a path, padded with zeros, which the
+// compiler folds into a constant. Keep in sync with lib/python/qmk/cli/telemetry.py
+#    define TRACE_FNV_STEP(h, s, i) (((h) ^ (uint8_t)(s)[(i) < sizeof(s) ? (i) : sizeof(s) - 1]) * UINT32_C(16777619))
+#    define TRACE_FNV_8(h, s, i) TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(TRACE_FNV_STEP(h, s, i), s, i + 1), s, i + 2), s, i + 3), s, i + 4), s, i + 5), s, i + 6), s, i + 7)
+#    define TRACE_FNV_64(h, s, i) TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(TRACE_FNV_8(h, s, i), s, i + 8), s, i + 16), s, i + 24), s, i + 32), s, i + 40), s, i + 48), s, i + 56)
+#    define TRACE_FILE_HASH(s) TRACE_FNV_64(TRACE_FNV_64(UINT32_C(0x811C9DC5), s, 0), s, 64)
+
+#    define TRACE_WRITE(fmt, ...) telemetry_trace(TRACE_MODULE_ID, TRACE_FILE_HASH(__FILE__), __LINE__, TRACE_NARGS(__VA_ARGS__) TRACE_CAT(TRACE_ARGS_, TRACE_NARGS(__VA_ARGS__))(__VA_ARGS__))
+#else
+#    include "debug.h"
+
+#    define TRACE_WRITE(fmt, ...) dprintf(fmt "\n", ##__VA_ARGS__)
+#endif
+
+#define TRACE(level, fmt, ...)                                              \
+    do {                                                                    \
+        if (TRACE_MODULE_LEVEL >= (level)) TRACE_WRITE(fmt, ##__VA_ARGS__); \
+    } while (0)
+
+#define trace_error(fmt, ...) TRACE(TRACE_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define trace_warn(fmt, ...) TRACE(TRACE_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define trace_info(fmt, ...) TRACE(TRACE_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define trace_debug(fmt, ...) TRACE(TRACE_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define trace_verbose(fmt, ...) TRACE(TRACE_LEVEL_VERBOSE, fmt, ##__VA_ARGS__)
@@ -169,6 +169,63 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_READ_PORTS
+#                ifndef readPort
+#                    error MATRIX_READ_PORTS is not supported on this platform
+#                endif
+
+/* Columns are read a whole GPIO port at a time.  Each run of columns wired to
+ * consecutive pads of the same port is extracted from the port value with a
+ * single mask and shift, and runs sharing a port are kept together so that
+ * the port only needs to be read once per row.
+ */
+typedef struct {
+    pin_t       pin;       // first pin of the run
+    port_data_t mask;      // run width, as a mask of low bits
+    uint8_t     col;       // first column of the run
+    bool        read_port; // port differs from the previous run
+} matrix_col_run_t;
+
+static matrix_col_run_t col_runs[MATRIX_COLS];
+static uint8_t          col_run_count = 0;
+
+static void matrix_init_col_runs(void) {
+    col_run_count = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        if (col_run_count > 0) {
+            matrix_col_run_t *run   = &col_runs[col_run_count - 1];
+            uint8_t           width = col - run->col;
+            if (getPinPort(run->pin) == getPinPort(pin) && getPinPad(run->pin) + width == getPinPad(pin) && run->mask == ((port_data_t)1 << width) - 1) {
+                run->mask |= (port_data_t)1 << width;
+                continue;
+            }
+        }
+        col_runs[col_run_count++] = (matrix_col_run_t){.pin = pin, .mask = 1, .col = col};
+    }
+
+    // Move each run up to just after the last earlier run on the same port
+    for (uint8_t i = 1; i < col_run_count; i++) {
+        matrix_col_run_t run = col_runs[i];
+        for (uint8_t j = i; j > 0; j--) {
+            if (getPinPort(col_runs[j - 1].pin) == getPinPort(run.pin)) {
+                memmove(&col_runs[j + 1], &col_runs[j], (i - j) * sizeof(matrix_col_run_t));
+                col_runs[j] = run;
+                break;
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < col_run_count; i++) {
+        col_runs[i].read_port = (i == 0) || (getPinPort(col_runs[i - 1].pin) != getPinPort(col_runs[i].pin));
+    }
+}
+#            endif
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -178,6 +235,19 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_PORTS
+    // For each run of cols...
+    port_data_t port_state = 0;
+    for (uint8_t run_index = 0; run_index < col_run_count; run_index++) {
+        const matrix_col_run_t *run = &col_runs[run_index];
+        if (run->read_port) {
+            port_state = ~readPort(run->pin);
+        }
+
+        // Populate the matrix row with the state of the col pins
+        current_row_value |= (matrix_row_t)((port_state >> getPinPad(run->pin)) & run->mask) << run->col;
+    }
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -186,6 +256,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -267,6 +338,95 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION != COL2ROW)
+#        error MATRIX_SCAN_ON_INTERRUPT requires DIRECT_PINS or DIODE_DIRECTION COL2ROW
+#    endif
+#    ifndef enablePinInterruptFalling
+#        error MATRIX_SCAN_ON_INTERRUPT is not supported on this platform
+#    endif
+
+/* While no key is held, all rows are selected at once and the inputs are left
+ * armed with falling edge interrupts, so that the matrix is only scanned again
+ * once something has been pressed.
+ */
+static volatile bool matrix_input_changed = true;
+static bool          matrix_armed         = false;
+
+static void matrix_input_interrupt(void *arg) {
+    matrix_input_changed = true;
+}
+
+static void matrix_set_input_interrupt(pin_t pin, bool enable) {
+    if (pin == NO_PIN) {
+        return;
+    }
+    if (enable) {
+        enablePinInterruptFalling(pin, matrix_input_interrupt);
+        // catch anything pressed before the interrupt was enabled
+        if (!readPin(pin)) {
+            matrix_input_changed = true;
+        }
+    } else {
+        disablePinInterrupt(pin);
+    }
+}
+
+static void matrix_set_input_interrupts(bool enable) {
+#    ifdef DIRECT_PINS
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_set_input_interrupt(direct_pins[row][col], enable);
+        }
+    }
+#    else
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        matrix_set_input_interrupt(col_pins[col], enable);
+    }
+#    endif
+}
+
+// Returns true if the matrix needs to be scanned, disarming it if so
+static bool matrix_scan_needed(void) {
+    if (!matrix_armed) {
+        return true;
+    }
+    if (!matrix_input_changed) {
+        return false;
+    }
+    matrix_set_input_interrupts(false);
+#    ifndef DIRECT_PINS
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+#    endif
+    matrix_armed = false;
+    return true;
+}
+
+// Arms the matrix again once nothing is held any more
+static void matrix_scan_done(matrix_row_t current_matrix[]) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (current_matrix[row]) {
+            return;
+        }
+    }
+#    ifndef DIRECT_PINS
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+#    endif
+    matrix_input_changed = false;
+    matrix_armed         = true;
+    matrix_set_input_interrupts(true);
+}
+#else
+static inline bool matrix_scan_needed(void) {
+    return true;
+}
+static inline void matrix_scan_done(matrix_row_t current_matrix[]) {}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -297,6 +457,10 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#if defined(MATRIX_READ_PORTS) && !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == COL2ROW)
+    matrix_init_col_runs();
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -321,9 +485,12 @@ uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
+    if (matrix_scan_needed()) {
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
+        matrix_scan_done(curr_matrix);
     }
 #elif (DIODE_DIRECTION == ROW2COL)
     // Set col, read rows
@@ -40,6 +40,58 @@ static uint8_t        mousekey_wheel_repeat = 0;
 static uint16_t mouse_timer = 0;
 #endif
 
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+/* Wheel motion owed to the host, in 1/256 of the units it expects */
+static int16_t  wheel_remainder_v = 0;
+static int16_t  wheel_remainder_h = 0;
+static uint16_t last_timer_hires  = 0;
+/* Kept apart from other sources of mouse reports, so that their scroll does not end up in ours */
+static mouse_scroll_carry_t wheel_carry = {};
+
+static bool wheel_hires_active(void) {
+    return host_mouse_scroll_multiplier(false) > 1 || host_mouse_scroll_multiplier(true) > 1;
+}
+
+/* Adds detents with 8 fractional bits to the wheel motion owed on one axis */
+static void wheel_hires_add(int16_t *remainder, int32_t detents, bool horizontal) {
+    int32_t total = *remainder + detents * host_mouse_scroll_multiplier(horizontal);
+    *remainder    = total > 127 * 256 ? 127 * 256 : (total < -127 * 256 ? -127 * 256 : total);
+}
+
+static int8_t wheel_hires_take(int16_t *remainder) {
+    int8_t units = *remainder / 256;
+    *remainder -= units * 256;
+    return units;
+}
+
+static bool wheel_hires_due(void) {
+    return wheel_remainder_v >= 256 || wheel_remainder_v <= -256 || wheel_remainder_h >= 256 || wheel_remainder_h <= -256;
+}
+
+/* Spreads a step of v and h detents every interval ms over every millisecond in between */
+static void wheel_hires_spread(int8_t v, int8_t h, uint16_t interval) {
+    uint16_t elapsed = timer_elapsed(last_timer_hires);
+    if (elapsed == 0) return;
+    last_timer_hires = timer_read();
+
+    if (interval == 0) interval = 1;
+    if (elapsed > interval) elapsed = interval;
+    wheel_hires_add(&wheel_remainder_v, ((int32_t)v << 8) * elapsed / interval, false);
+    wheel_hires_add(&wheel_remainder_h, ((int32_t)h << 8) * elapsed / interval, true);
+}
+
+/* The first step of a wheel key is sent right away, like in detent mode */
+static void wheel_hires_press(uint8_t code) {
+    if (!wheel_hires_active()) return;
+    last_timer_hires = timer_read();
+    if (code == KC_MS_WH_UP || code == KC_MS_WH_DOWN) {
+        wheel_hires_add(&wheel_remainder_v, (int32_t)mouse_report.v << 8, false);
+    } else {
+        wheel_hires_add(&wheel_remainder_h, (int32_t)mouse_report.h << 8, true);
+    }
+}
+#endif
+
 #ifndef MK_3_SPEED
 
 static uint16_t last_timer_c = 0;
@@ -233,6 +285,32 @@ void mousekey_task(void) {
             }
         }
     }
+#    ifdef MOUSE_SCROLL_HIRES_ENABLE
+    if ((tmpmr.v || tmpmr.h) && wheel_hires_active()) {
+        // steps still repeat and accelerate as in detent mode, but are sent a little every report
+        if (timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
+            if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
+            last_timer_w = timer_read();
+        }
+        if (mousekey_wheel_repeat == 0) {
+            last_timer_hires = timer_read();
+        } else {
+            int8_t const unit = wheel_unit();
+            int8_t       v    = tmpmr.v ? ((tmpmr.v > 0) ? unit : -unit) : 0;
+            int8_t       h    = tmpmr.h ? ((tmpmr.h > 0) ? unit : -unit) : 0;
+            if (v && h) {
+                v = times_inv_sqrt2(v);
+                h = times_inv_sqrt2(h);
+            }
+            wheel_hires_spread(v, h, mk_wheel_interval);
+        }
+        // mousekey_send() replaces these with the units that are due
+        if (wheel_hires_due()) {
+            mouse_report.v = tmpmr.v;
+            mouse_report.h = tmpmr.h;
+        }
+    } else
+#    endif
     if ((tmpmr.v || tmpmr.h) && timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
         if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
         if (tmpmr.v != 0) mouse_report.v = wheel_unit() * ((tmpmr.v > 0) ? 1 : -1);
@@ -286,6 +364,9 @@ void mousekey_on(uint8_t code) {
         mousekey_accel |= (1 << 1);
     else if (code == KC_MS_ACCEL2)
         mousekey_accel |= (1 << 2);
+#    ifdef MOUSE_SCROLL_HIRES_ENABLE
+    if (IS_MOUSEKEY_WHEEL(code)) wheel_hires_press(code);
+#    endif
 }
 
 void mousekey_off(uint8_t code) {
@@ -350,6 +431,16 @@ void mousekey_task(void) {
         mouse_report.x = tmpmr.x;
         mouse_report.y = tmpmr.y;
     }
+#    ifdef MOUSE_SCROLL_HIRES_ENABLE
+    if ((tmpmr.h || tmpmr.v) && wheel_hires_active()) {
+        wheel_hires_spread(tmpmr.v, tmpmr.h, w_intervals[mk_speed]);
+        // mousekey_send() replaces these with the units that are due
+        if (wheel_hires_due()) {
+            mouse_report.v = tmpmr.v;
+            mouse_report.h = tmpmr.h;
+        }
+    } else
+#    endif
     if ((tmpmr.h || tmpmr.v) && timer_elapsed(last_timer_w) > w_intervals[mk_speed]) {
         mouse_report.v = tmpmr.v;
         mouse_report.h = tmpmr.h;
@@ -416,6 +507,9 @@ void mousekey_on(uint8_t code) {
     else if (code == KC_MS_ACCEL2)
         mk_speed = mkspd_2;
     if (mk_speed != old_speed) adjust_speed();
+#    ifdef MOUSE_SCROLL_HIRES_ENABLE
+    if (IS_MOUSEKEY_WHEEL(code)) wheel_hires_press(code);
+#    endif
 }
 
 void mousekey_off(uint8_t code) {
@@ -457,8 +551,22 @@ void mousekey_send(void) {
     mousekey_debug();
     uint16_t time = timer_read();
     if (mouse_report.x || mouse_report.y) last_timer_c = time;
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    if (wheel_hires_active()) {
+        // the held wheel keys only set the speed, what is sent is the motion accumulated for this report
+        report_mouse_t report = mouse_report;
+        report.v              = wheel_hires_take(&wheel_remainder_v);
+        report.h              = wheel_hires_take(&wheel_remainder_h);
+        host_mouse_send_hires(&report, &wheel_carry);
+        return;
+    }
+#endif
     if (mouse_report.v || mouse_report.h) last_timer_w = time;
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    host_mouse_send_detents(&mouse_report, &wheel_carry);
+#else
     host_mouse_send(&mouse_report);
+#endif
 }
 
 void mousekey_clear(void) {
@@ -466,6 +574,10 @@ void mousekey_clear(void) {
     mousekey_repeat       = 0;
     mousekey_wheel_repeat = 0;
     mousekey_accel        = 0;
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    wheel_remainder_v = 0;
+    wheel_remainder_h = 0;
+#endif
 }
 
 static void mousekey_debug(void) {
@@ -136,6 +136,37 @@ __attribute__((weak)) uint8_t pointing_device_handle_buttons(uint8_t buttons, bo
     return buttons;
 }
 
+#ifdef POINTING_DEVICE_MOTION_PIN
+static volatile bool motion_latched = false;
+static bool          motion_carry   = false;
+
+#    ifdef POINTING_DEVICE_MOTION_PIN_INTERRUPT
+#        ifndef enablePinInterruptFalling
+#            error POINTING_DEVICE_MOTION_PIN_INTERRUPT is not supported on this platform
+#        endif
+/**
+ * @brief Latches motion signalled by the sensor between two polls
+ */
+static void pointing_device_motion_interrupt(void *arg) {
+    motion_latched = true;
+}
+#    endif
+
+/**
+ * @brief Checks whether the sensor needs to be read
+ *
+ * True while the motion pin is active or was activated since the last call. The sensor is also read once more after
+ * any report with motion, so that drivers can send motion that did not fit in the previous report.
+ *
+ * @return bool motion pending
+ */
+static bool pointing_device_motion_pending(void) {
+    bool pending   = motion_latched;
+    motion_latched = false;
+    return pending || motion_carry || !readPin(POINTING_DEVICE_MOTION_PIN);
+}
+#endif
+
 /**
  * @brief Initialises pointing device
  *
@@ -150,6 +181,12 @@ __attribute__((weak)) void pointing_device_init(void) {
     pointing_device_driver.init();
 #ifdef POINTING_DEVICE_MOTION_PIN
     setPinInputHigh(POINTING_DEVICE_MOTION_PIN);
+#    ifdef POINTING_DEVICE_MOTION_PIN_INTERRUPT
+    enablePinInterruptFalling(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_interrupt);
+#    endif
+#endif
+#ifdef POINTING_DEVICE_TRANSFORM_ENABLE
+    pointing_device_transform_init();
 #endif
     pointing_device_init_kb();
     pointing_device_init_user();
@@ -165,9 +202,25 @@ __attribute__((weak)) void pointing_device_send(void) {
     static report_mouse_t old_report = {};
 
     // If you need to do other things, like debugging, this is the place to do it.
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    // kept apart from mouse keys, so that neither sends the scroll of the other
+    static mouse_scroll_carry_t scroll_carry = {};
+
+    // scroll that did not fit in the last report is sent even if nothing else changed
+    if (has_mouse_report_changed(local_mouse_report, old_report) || host_mouse_scroll_pending(&scroll_carry)) {
+#    ifdef POINTING_DEVICE_TRANSFORM_ENABLE
+        // drag scroll already produces fractions of a detent in the units the host expects
+        if (pointing_device_get_drag_scroll()) {
+            host_mouse_send_hires(&local_mouse_report, &scroll_carry);
+        } else
+#    endif
+            host_mouse_send_detents(&local_mouse_report, &scroll_carry);
+    }
+#else
     if (has_mouse_report_changed(local_mouse_report, old_report)) {
         host_mouse_send(&local_mouse_report);
     }
+#endif
     // send it and 0 it out except for buttons, so those stay until they are explicity over-ridden using update_pointing_device
     local_mouse_report.x = 0;
     local_mouse_report.y = 0;
@@ -188,7 +241,7 @@ __attribute__((weak)) void pointing_device_send(void) {
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     // Support rotation of the sensor data
 #if defined(POINTING_DEVICE_ROTATION_90) || defined(POINTING_DEVICE_ROTATION_180) || defined(POINTING_DEVICE_ROTATION_270)
-    int8_t x = mouse_report.x, y = mouse_report.y;
+    mouse_xy_report_t x = mouse_report.x, y = mouse_report.y;
 #    if defined(POINTING_DEVICE_ROTATION_90)
     mouse_report.x = y;
     mouse_report.y = -x;
@@ -212,6 +265,25 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+/**
+ * @brief Clamps sensor motion to the mouse report range, carrying the excess over
+ *
+ * Adds the motion left over from the previous call to value, returns as much as fits in a mouse report and keeps the
+ * remainder in residual. Motion beyond the report range is sent with the following reports instead of being dropped.
+ *
+ * @param[in] value int16_t motion read from the sensor
+ * @param[in,out] residual int16_t motion carried over between calls
+ * @return mouse_xy_report_t clamped value
+ */
+mouse_xy_report_t pointing_device_xy_carry(int16_t value, int16_t *residual) {
+    int32_t           total   = (int32_t)value + *residual;
+    mouse_xy_report_t clamped = total < MOUSE_REPORT_XY_MIN ? MOUSE_REPORT_XY_MIN : (total > MOUSE_REPORT_XY_MAX ? MOUSE_REPORT_XY_MAX : total);
+
+    total -= clamped;
+    *residual = total < INT16_MIN ? INT16_MIN : (total > INT16_MAX ? INT16_MAX : total);
+    return clamped;
+}
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -236,24 +308,26 @@ __attribute__((weak)) void pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
-    if (!readPin(POINTING_DEVICE_MOTION_PIN))
+#if defined(POINTING_DEVICE_MOTION_PIN) && defined(SPLIT_POINTING_ENABLE)
+#    error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
 #    if defined(POINTING_DEVICE_COMBINED)
-        static uint8_t old_buttons = 0;
+    static uint8_t old_buttons = 0;
     local_mouse_report.buttons = old_buttons;
     local_mouse_report         = pointing_device_driver.get_report(local_mouse_report);
     old_buttons                = local_mouse_report.buttons;
 #    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
-        local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver.get_report(local_mouse_report) : shared_mouse_report;
+    local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver.get_report(local_mouse_report) : shared_mouse_report;
 #    else
 #        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
 #    endif
+#elif defined(POINTING_DEVICE_MOTION_PIN)
+    if (pointing_device_motion_pending()) {
+        local_mouse_report = pointing_device_driver.get_report(local_mouse_report);
+        motion_carry       = local_mouse_report.x || local_mouse_report.y;
+    }
 #else
     local_mouse_report = pointing_device_driver.get_report(local_mouse_report);
 #endif // defined(SPLIT_POINTING_ENABLE)
@@ -276,6 +350,9 @@ __attribute__((weak)) void pointing_device_task(void) {
 #ifdef MOUSEKEY_ENABLE
     report_mouse_t mousekey_report = mousekey_get_report();
     local_mouse_report.buttons     = local_mouse_report.buttons | mousekey_report.buttons;
+#endif
+#ifdef POINTING_DEVICE_TRANSFORM_ENABLE
+    local_mouse_report = pointing_device_transform(local_mouse_report);
 #endif
     pointing_device_send();
 }
@@ -368,10 +445,26 @@ static inline int8_t pointing_device_movement_clamp(int16_t value) {
     }
 }
 
+/**
+ * @brief clamps int32_t to the mouse report x/y range
+ *
+ * @param[in] int32_t value
+ * @return mouse_xy_report_t clamped value
+ */
+static inline mouse_xy_report_t pointing_device_xy_clamp(int32_t value) {
+    if (value < MOUSE_REPORT_XY_MIN) {
+        return MOUSE_REPORT_XY_MIN;
+    } else if (value > MOUSE_REPORT_XY_MAX) {
+        return MOUSE_REPORT_XY_MAX;
+    } else {
+        return value;
+    }
+}
+
 /**
  * @brief combines 2 mouse reports and returns 2
  *
- * Combines 2 report_mouse_t structs, clamping movement values to int8_t and ignores report_id then returns the resulting report_mouse_t struct.
+ * Combines 2 report_mouse_t structs, clamping movement values to the report range and ignores report_id then returns the resulting report_mouse_t struct.
  *
  * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
  *
@@ -380,8 +473,8 @@ static inline int8_t pointing_device_movement_clamp(int16_t value) {
  * @return combined report_mouse_t of left_report and right_report
  */
 report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, report_mouse_t right_report) {
-    left_report.x = pointing_device_movement_clamp((int16_t)left_report.x + right_report.x);
-    left_report.y = pointing_device_movement_clamp((int16_t)left_report.y + right_report.y);
+    left_report.x = pointing_device_xy_clamp((int32_t)left_report.x + right_report.x);
+    left_report.y = pointing_device_xy_clamp((int32_t)left_report.y + right_report.y);
     left_report.h = pointing_device_movement_clamp((int16_t)left_report.h + right_report.h);
     left_report.v = pointing_device_movement_clamp((int16_t)left_report.v + right_report.v);
     left_report.buttons |= right_report.buttons;
@@ -401,7 +494,7 @@ report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, repor
 report_mouse_t pointing_device_adjust_by_defines_right(report_mouse_t mouse_report) {
     // Support rotation of the sensor data
 #    if defined(POINTING_DEVICE_ROTATION_90_RIGHT) || defined(POINTING_DEVICE_ROTATION_RIGHT) || defined(POINTING_DEVICE_ROTATION_RIGHT)
-    int8_t x = mouse_report.x, y = mouse_report.y;
+    mouse_xy_report_t x = mouse_report.x, y = mouse_report.y;
 #        if defined(POINTING_DEVICE_ROTATION_90_RIGHT)
     mouse_report.x = y;
     mouse_report.y = -x;
@@ -84,12 +84,13 @@ bool           has_mouse_report_changed(report_mouse_t new_report, report_mouse_
 uint16_t       pointing_device_get_cpi(void);
 void           pointing_device_set_cpi(uint16_t cpi);
 
-void           pointing_device_init_kb(void);
-void           pointing_device_init_user(void);
-report_mouse_t pointing_device_task_kb(report_mouse_t mouse_report);
-report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
-uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
-report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
+void              pointing_device_init_kb(void);
+void              pointing_device_init_user(void);
+report_mouse_t    pointing_device_task_kb(report_mouse_t mouse_report);
+report_mouse_t    pointing_device_task_user(report_mouse_t mouse_report);
+uint8_t           pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
+report_mouse_t    pointing_device_adjust_by_defines(report_mouse_t mouse_report);
+mouse_xy_report_t pointing_device_xy_carry(int16_t value, int16_t *residual);
 
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
@@ -105,3 +106,7 @@ report_mouse_t pointing_device_task_combined_user(report_mouse_t left_report, re
 report_mouse_t pointing_device_adjust_by_defines_right(report_mouse_t mouse_report);
 #    endif // defined(POINTING_DEVICE_COMBINED)
 #endif     // defined(SPLIT_POINTING_ENABLE)
+
+#ifdef POINTING_DEVICE_TRANSFORM_ENABLE
+#    include "pointing_device_transform.h"
+#endif
@@ -22,9 +22,6 @@
 #include "timer.h"
 #include <stddef.h>
 
-// hid mouse reports cannot exceed -127 to 127, so constrain to that value
-#define constrain_hid(amt) ((amt) < -127 ? -127 : ((amt) > 127 ? 127 : (amt)))
-
 // get_report functions should probably be moved to their respective drivers.
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
 report_mouse_t adns5050_get_report(report_mouse_t mouse_report) {
@@ -54,12 +51,10 @@ const pointing_device_driver_t pointing_device_driver = {
 
 report_mouse_t adns9800_get_report_driver(report_mouse_t mouse_report) {
     report_adns9800_t sensor_report = adns9800_get_report();
+    static int16_t    residual_x = 0, residual_y = 0;
 
-    int8_t clamped_x = constrain_hid(sensor_report.x);
-    int8_t clamped_y = constrain_hid(sensor_report.y);
-
-    mouse_report.x = clamped_x;
-    mouse_report.y = clamped_y;
+    mouse_report.x = pointing_device_xy_carry(sensor_report.x, &residual_x);
+    mouse_report.y = pointing_device_xy_carry(sensor_report.y, &residual_y);
 
     return mouse_report;
 }
@@ -180,10 +175,8 @@ report_mouse_t pimoroni_trackball_get_report(report_mouse_t mouse_report) {
             if (!(pimoroni_data.click & 128)) {
                 mouse_report.buttons = pointing_device_handle_buttons(mouse_report.buttons, false, POINTING_DEVICE_BUTTON1);
                 if (!debounce) {
-                    x_offset += pimoroni_trackball_get_offsets(pimoroni_data.right, pimoroni_data.left, PIMORONI_TRACKBALL_SCALE);
-                    y_offset += pimoroni_trackball_get_offsets(pimoroni_data.down, pimoroni_data.up, PIMORONI_TRACKBALL_SCALE);
-                    pimoroni_trackball_adapt_values(&mouse_report.x, &x_offset);
-                    pimoroni_trackball_adapt_values(&mouse_report.y, &y_offset);
+                    mouse_report.x = pointing_device_xy_carry(pimoroni_trackball_get_offsets(pimoroni_data.right, pimoroni_data.left, PIMORONI_TRACKBALL_SCALE), &x_offset);
+                    mouse_report.y = pointing_device_xy_carry(pimoroni_trackball_get_offsets(pimoroni_data.down, pimoroni_data.up, PIMORONI_TRACKBALL_SCALE), &y_offset);
                 } else {
                     debounce--;
                 }
@@ -214,6 +207,7 @@ static void pmw3360_device_init(void) {
 report_mouse_t pmw3360_get_report(report_mouse_t mouse_report) {
     report_pmw3360_t data        = pmw3360_read_burst();
     static uint16_t  MotionStart = 0; // Timer for accel, 0 is resting state
+    static int16_t   residual_x = 0, residual_y = 0;
 
     if (data.isOnSurface && data.isMotion) {
         // Reset timer if stopped moving
@@ -229,8 +223,12 @@ report_mouse_t pmw3360_get_report(report_mouse_t mouse_report) {
 #    endif
             MotionStart = timer_read();
         }
-        mouse_report.x = constrain_hid(data.dx);
-        mouse_report.y = constrain_hid(data.dy);
+        mouse_report.x = pointing_device_xy_carry(data.dx, &residual_x);
+        mouse_report.y = pointing_device_xy_carry(data.dy, &residual_y);
+    } else if (residual_x || residual_y) {
+        // Keep sending motion that did not fit in earlier reports
+        mouse_report.x = pointing_device_xy_carry(0, &residual_x);
+        mouse_report.y = pointing_device_xy_carry(0, &residual_y);
     }
 
     return mouse_report;
@@ -252,6 +250,7 @@ static void pmw3389_device_init(void) {
 report_mouse_t pmw3389_get_report(report_mouse_t mouse_report) {
     report_pmw3389_t data        = pmw3389_read_burst();
     static uint16_t  MotionStart = 0; // Timer for accel, 0 is resting state
+    static int16_t   residual_x = 0, residual_y = 0;
 
     if (data.isOnSurface && data.isMotion) {
         // Reset timer if stopped moving
@@ -267,8 +266,12 @@ report_mouse_t pmw3389_get_report(report_mouse_t mouse_report) {
 #    endif
             MotionStart = timer_read();
         }
-        mouse_report.x = constrain_hid(data.dx);
-        mouse_report.y = constrain_hid(data.dy);
+        mouse_report.x = pointing_device_xy_carry(data.dx, &residual_x);
+        mouse_report.y = pointing_device_xy_carry(data.dy, &residual_y);
+    } else if (residual_x || residual_y) {
+        // Keep sending motion that did not fit in earlier reports
+        mouse_report.x = pointing_device_xy_carry(0, &residual_x);
+        mouse_report.y = pointing_device_xy_carry(0, &residual_y);
     }
 
     return mouse_report;
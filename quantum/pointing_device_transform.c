@@ -0,0 +1,271 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef POINTING_DEVICE_TRANSFORM_ENABLE
+
+#    include "pointing_device_transform.h"
+#    include "host.h"
+#    include "progmem.h"
+
+#    ifndef MIN
+#        define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#    endif
+#    ifndef MAX
+#        define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#    endif
+
+/* Motion is carried between the stages with 4 fractional bits, the rotation and
+ * scale matrix has 12 and the sine table 14.  With these the products of the
+ * largest report values and factors still fit in 32 bits. */
+#    define MOTION_UNIT 16
+#    define MOTION_LIMIT ((int32_t)MOUSE_REPORT_XY_MAX * MOTION_UNIT)
+#    define SCALE_MAX 2047
+#    define ACCEL_GAIN_MAX 4095
+
+_Static_assert((POINTING_DEVICE_ACCEL_STEP & (POINTING_DEVICE_ACCEL_STEP - 1)) == 0, "POINTING_DEVICE_ACCEL_STEP must be a power of two");
+_Static_assert(POINTING_DEVICE_DRAG_SCROLL_DIVISOR > 0, "POINTING_DEVICE_DRAG_SCROLL_DIVISOR must be positive");
+
+// sin(0..90 degrees), 14 fractional bits
+static const int16_t PROGMEM sine_table[91] = {
+    // clang-format off
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+    // clang-format on
+};
+
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+// gain per POINTING_DEVICE_ACCEL_STEP counts of speed, 8 fractional bits
+static const uint16_t PROGMEM accel_curve[] = POINTING_DEVICE_ACCEL_CURVE;
+#        define ACCEL_CURVE_LENGTH (sizeof(accel_curve) / sizeof(accel_curve[0]))
+#    endif
+
+static int16_t  rotation = POINTING_DEVICE_ROTATION_ANGLE;
+static uint16_t scale_x  = POINTING_DEVICE_SCALE_X;
+static uint16_t scale_y  = POINTING_DEVICE_SCALE_Y;
+static bool     drag_scroll;
+
+// rotation and scale, 12 fractional bits
+static int16_t matrix_xx, matrix_xy, matrix_yx, matrix_yy;
+
+static int32_t residual_x, residual_y, residual_h, residual_v;
+
+/**
+ * @brief Looks up the sine of an angle
+ *
+ * @param[in] degrees int16_t angle
+ * @return int16_t sine with 14 fractional bits
+ */
+static int16_t transform_sin(int16_t degrees) {
+    degrees %= 360;
+    if (degrees < 0) {
+        degrees += 360;
+    }
+
+    if (degrees <= 90) {
+        return pgm_read_word(&sine_table[degrees]);
+    } else if (degrees <= 180) {
+        return pgm_read_word(&sine_table[180 - degrees]);
+    } else if (degrees <= 270) {
+        return -pgm_read_word(&sine_table[degrees - 180]);
+    } else {
+        return -pgm_read_word(&sine_table[360 - degrees]);
+    }
+}
+
+/**
+ * @brief Rebuilds the rotation and scale matrix from the current settings
+ *
+ * Rotating by 90 degrees matches POINTING_DEVICE_ROTATION_90.
+ */
+static void transform_update_matrix(void) {
+    int32_t sine   = transform_sin(rotation);
+    int32_t cosine = transform_sin(rotation + 90);
+
+    matrix_xx = (cosine * scale_x) >> 10;
+    matrix_xy = (sine * scale_x) >> 10;
+    matrix_yx = (-sine * scale_y) >> 10;
+    matrix_yy = (cosine * scale_y) >> 10;
+}
+
+/**
+ * @brief Moves whole units out of an accumulator
+ *
+ * Adds value to the accumulator and takes out as many whole units as fit within limit. The rest, including anything
+ * beyond limit, stays in the accumulator for the next report.
+ *
+ * @param[in,out] accumulator int32_t fixed point remainder
+ * @param[in] value int32_t fixed point motion to add
+ * @param[in] unit int32_t fixed point value of one report count
+ * @param[in] limit int32_t largest report value
+ * @return int32_t report value
+ */
+static int32_t transform_take(int32_t *accumulator, int32_t value, int32_t unit, int32_t limit) {
+    int32_t total = *accumulator + value;
+    int32_t count = total / unit;
+
+    if (count > limit) {
+        count = limit;
+    } else if (count < -limit) {
+        count = -limit;
+    }
+
+    total -= count * unit;
+    if (total > limit * unit) {
+        total = limit * unit;
+    } else if (total < -limit * unit) {
+        total = -limit * unit;
+    }
+    *accumulator = total;
+    return count;
+}
+
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+/**
+ * @brief Interpolates the acceleration curve for the speed of this report
+ *
+ * @param[in] x int32_t motion with 4 fractional bits
+ * @param[in] y int32_t motion with 4 fractional bits
+ * @return int32_t gain with 8 fractional bits
+ */
+static int32_t transform_accel_gain(int32_t x, int32_t y) {
+    uint32_t ax = (x < 0 ? -x : x) / MOTION_UNIT;
+    uint32_t ay = (y < 0 ? -y : y) / MOTION_UNIT;
+    // approximates sqrt(ax^2 + ay^2) within a few percent
+    uint32_t speed = MAX(ax, ay) + (MIN(ax, ay) * 3) / 8;
+    uint32_t index = speed / POINTING_DEVICE_ACCEL_STEP;
+    int32_t  gain;
+
+    if (index >= ACCEL_CURVE_LENGTH - 1) {
+        gain = pgm_read_word(&accel_curve[ACCEL_CURVE_LENGTH - 1]);
+    } else {
+        int32_t low  = pgm_read_word(&accel_curve[index]);
+        int32_t high = pgm_read_word(&accel_curve[index + 1]);
+        gain         = low + (high - low) * (int32_t)(speed % POINTING_DEVICE_ACCEL_STEP) / POINTING_DEVICE_ACCEL_STEP;
+    }
+    return MIN(gain, ACCEL_GAIN_MAX);
+}
+#    endif
+
+/**
+ * @brief Initialises the transform pipeline from the configured defaults
+ */
+void pointing_device_transform_init(void) {
+    transform_update_matrix();
+    residual_x = residual_y = residual_h = residual_v = 0;
+}
+
+/**
+ * @brief Applies rotation, scaling, acceleration and drag scroll to a mouse report
+ *
+ * Fractions of a count are kept between reports, so slow motion is not lost to rounding at small scale factors.
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t transformed report
+ */
+report_mouse_t pointing_device_transform(report_mouse_t mouse_report) {
+    int32_t x = ((int32_t)matrix_xx * mouse_report.x + (int32_t)matrix_xy * mouse_report.y) / 256;
+    int32_t y = ((int32_t)matrix_yx * mouse_report.x + (int32_t)matrix_yy * mouse_report.y) / 256;
+
+    if (drag_scroll) {
+        const int32_t unit = MOTION_UNIT * POINTING_DEVICE_DRAG_SCROLL_DIVISOR;
+        int32_t       h    = x + mouse_report.h * unit;
+        int32_t       v    = y + mouse_report.v * unit;
+
+#    ifdef MOUSE_SCROLL_HIRES_ENABLE
+        // fractions of a detent are sent to hosts that enabled high resolution scrolling
+        h *= host_mouse_scroll_multiplier(true);
+        v *= host_mouse_scroll_multiplier(false);
+#    endif
+        mouse_report.h = transform_take(&residual_h, h, unit, 127);
+        mouse_report.v = transform_take(&residual_v, v, unit, 127);
+        mouse_report.x = 0;
+        mouse_report.y = 0;
+        return mouse_report;
+    }
+
+#    ifdef POINTING_DEVICE_ACCEL_CURVE
+    x = x > MOTION_LIMIT ? MOTION_LIMIT : (x < -MOTION_LIMIT ? -MOTION_LIMIT : x);
+    y = y > MOTION_LIMIT ? MOTION_LIMIT : (y < -MOTION_LIMIT ? -MOTION_LIMIT : y);
+
+    int32_t gain = transform_accel_gain(x, y);
+    x            = x * gain / POINTING_DEVICE_TRANSFORM_UNITY;
+    y            = y * gain / POINTING_DEVICE_TRANSFORM_UNITY;
+#    endif
+
+    mouse_report.x = transform_take(&residual_x, x, MOTION_UNIT, MOUSE_REPORT_XY_MAX);
+    mouse_report.y = transform_take(&residual_y, y, MOTION_UNIT, MOUSE_REPORT_XY_MAX);
+    return mouse_report;
+}
+
+/**
+ * @brief Sets the rotation applied to pointer motion
+ *
+ * @param[in] degrees int16_t clockwise rotation
+ */
+void pointing_device_set_rotation(int16_t degrees) {
+    rotation = degrees % 360;
+    transform_update_matrix();
+}
+
+int16_t pointing_device_get_rotation(void) {
+    return rotation;
+}
+
+/**
+ * @brief Sets the per axis scale applied to pointer motion
+ *
+ * @param[in] x uint16_t scale with 8 fractional bits, below 8.0
+ * @param[in] y uint16_t scale with 8 fractional bits, below 8.0
+ */
+void pointing_device_set_scale(uint16_t x, uint16_t y) {
+    scale_x = MIN(x, SCALE_MAX);
+    scale_y = MIN(y, SCALE_MAX);
+    transform_update_matrix();
+}
+
+uint16_t pointing_device_get_scale_x(void) {
+    return scale_x;
+}
+
+uint16_t pointing_device_get_scale_y(void) {
+    return scale_y;
+}
+
+/**
+ * @brief Turns pointer motion into scrolling
+ *
+ * @param[in] enable bool
+ */
+void pointing_device_set_drag_scroll(bool enable) {
+    if (enable != drag_scroll) {
+        drag_scroll = enable;
+        residual_x = residual_y = residual_h = residual_v = 0;
+    }
+}
+
+bool pointing_device_get_drag_scroll(void) {
+    return drag_scroll;
+}
+
+#endif // POINTING_DEVICE_TRANSFORM_ENABLE
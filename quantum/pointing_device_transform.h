@@ -0,0 +1,51 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "report.h"
+
+/* Scale factors are fixed point with 8 fractional bits, so 256 is 1.0. */
+#define POINTING_DEVICE_TRANSFORM_UNITY 256
+
+#ifndef POINTING_DEVICE_ROTATION_ANGLE
+#    define POINTING_DEVICE_ROTATION_ANGLE 0
+#endif
+#ifndef POINTING_DEVICE_SCALE_X
+#    define POINTING_DEVICE_SCALE_X POINTING_DEVICE_TRANSFORM_UNITY
+#endif
+#ifndef POINTING_DEVICE_SCALE_Y
+#    define POINTING_DEVICE_SCALE_Y POINTING_DEVICE_TRANSFORM_UNITY
+#endif
+#ifndef POINTING_DEVICE_ACCEL_STEP
+#    define POINTING_DEVICE_ACCEL_STEP 4
+#endif
+#ifndef POINTING_DEVICE_DRAG_SCROLL_DIVISOR
+#    define POINTING_DEVICE_DRAG_SCROLL_DIVISOR 8
+#endif
+
+void           pointing_device_transform_init(void);
+report_mouse_t pointing_device_transform(report_mouse_t mouse_report);
+
+void     pointing_device_set_rotation(int16_t degrees);
+int16_t  pointing_device_get_rotation(void);
+void     pointing_device_set_scale(uint16_t scale_x, uint16_t scale_y);
+uint16_t pointing_device_get_scale_x(void);
+uint16_t pointing_device_get_scale_y(void);
+void     pointing_device_set_drag_scroll(bool enable);
+bool     pointing_device_get_drag_scroll(void);
@@ -198,6 +198,11 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
+/* Calls a process_* handler only for keycodes within the first..last
+    range it handles, the unsigned subtraction makes it one compare.
+    Handlers that look at every keycode are called directly.      */
+#define PROCESS_RANGE(first, last, handler) ((uint16_t)(keycode - (first)) > (uint16_t)((last) - (first)) || handler(keycode, record))
+
 /* Core keycode function, hands off handling to other functions,
     then processes internal quantum keycodes, and then processes
     ACTIONs.                                                      */
@@ -248,19 +253,19 @@ bool process_record_quantum(keyrecord_t *record) {
 #endif
             process_record_kb(keycode, record) &&
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            PROCESS_RANGE(SQ_ON, SEQUENCER_TRACK_MAX, process_sequencer) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            PROCESS_RANGE(MIDI_TONE_MIN, MI_BENDU, process_midi) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            PROCESS_RANGE(AU_ON, MUV_DE, process_audio) &&
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+            PROCESS_RANGE(BL_ON, BL_BRTG, process_backlight) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            PROCESS_RANGE(QK_STENO, QK_STENO_MAX, process_steno) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -284,7 +289,7 @@ bool process_record_quantum(keyrecord_t *record) {
             process_auto_shift(keycode, record) &&
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+            PROCESS_RANGE(DT_PRNT, DT_DOWN, process_dynamic_tapping_term) &&
 #endif
 #ifdef TERMINAL_ENABLE
             process_terminal(keycode, record) &&
@@ -293,19 +298,19 @@ bool process_record_quantum(keyrecord_t *record) {
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_KEYCODE_ENABLE
-            process_magic(keycode, record) &&
+            PROCESS_RANGE(MAGIC_SWAP_CONTROL_CAPSLOCK, MAGIC_TOGGLE_CONTROL_CAPSLOCK, process_magic) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+            PROCESS_RANGE(QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, process_grave_esc) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+            PROCESS_RANGE(RGB_TOG, RGB_MODE_TWINKLE, process_rgb) &&
 #endif
 #ifdef JOYSTICK_ENABLE
             process_joystick(keycode, record) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            PROCESS_RANGE(PROGRAMMABLE_BUTTON_MIN, PROGRAMMABLE_BUTTON_MAX, process_programmable_button) &&
 #endif
             true)) {
         return false;
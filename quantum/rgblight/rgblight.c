@@ -119,6 +119,11 @@ static bool pre_suspend_enabled;
 
 #ifdef RGBLIGHT_USE_TIMER
 animation_status_t animation_status = {};
+
+// effects draw into led[] at their own interval, but the LEDs are written at most every RGBLIGHT_LED_FLUSH_LIMIT ms
+static bool     rgblight_defer_set;
+static bool     rgblight_frame_pending;
+static uint16_t rgblight_frame_timer;
 #endif
 
 #ifndef LED_ARRAY
@@ -249,6 +254,7 @@ void rgblight_init(void) {
     eeconfig_debug_rgblight(); // display current eeprom values
 
     rgblight_timer_init(); // setup the timer
+    rgblight_invalidate_frame();
 
     if (rgblight_config.enable) {
         rgblight_mode_noeeprom(rgblight_config.mode);
@@ -869,6 +875,8 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+    // the strip may have lost power while suspended, so the next frame has to be sent in full
+    rgblight_invalidate_frame();
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -891,10 +899,35 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
+#    ifdef RGBLIGHT_FRAME_CACHE
+static LED_TYPE led_sent[RGBLED_NUM];
+static uint8_t  led_sent_start = UINT8_MAX; // nothing sent yet, so the first frame always goes out
+static uint8_t  led_sent_num;
+
+/* Remembers the frame sent to the driver, returns false if it is the same as the previous one */
+static bool rgblight_frame_changed(LED_TYPE *start_led, uint8_t num_leds) {
+    if (led_sent_start == rgblight_ranges.clipping_start_pos && led_sent_num == num_leds && memcmp(led_sent, start_led, sizeof(LED_TYPE) * num_leds) == 0) {
+        return false;
+    }
+    memcpy(led_sent, start_led, sizeof(LED_TYPE) * num_leds);
+    led_sent_start = rgblight_ranges.clipping_start_pos;
+    led_sent_num   = num_leds;
+    return true;
+}
+#    endif
+
 void rgblight_set(void) {
     LED_TYPE *start_led;
     uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
 
+#    ifdef RGBLIGHT_USE_TIMER
+    if (rgblight_defer_set) {
+        rgblight_frame_pending = true;
+        return;
+    }
+    rgblight_frame_pending = false;
+#    endif
+
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
             led[i].r = 0;
@@ -932,11 +965,22 @@ void rgblight_set(void) {
     for (uint8_t i = 0; i < num_leds; i++) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
+#    endif
+#    ifdef RGBLIGHT_FRAME_CACHE
+    if (!rgblight_frame_changed(start_led, num_leds)) {
+        return;
+    }
 #    endif
     rgblight_call_driver(start_led, num_leds);
 }
 #endif
 
+void rgblight_invalidate_frame(void) {
+#if !defined(RGBLIGHT_CUSTOM_DRIVER) && defined(RGBLIGHT_FRAME_CACHE)
+    led_sent_start = UINT8_MAX;
+#endif
+}
+
 #ifdef RGBLIGHT_SPLIT
 /* for split keyboard master side */
 uint8_t rgblight_get_change_flags(void) {
@@ -981,7 +1025,9 @@ void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
     }
 #        ifndef RGBLIGHT_SPLIT_NO_ANIMATION_SYNC
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_ANIMATION_TICK) {
-        animation_status.restart = true;
+        // follow the master's phase instead of restarting whenever the sync arrives
+        animation_status.last_timer = syncinfo->status.animation_restart_timer;
+        animation_status.pos16      = 0;
     }
 #        endif /* RGBLIGHT_SPLIT_NO_ANIMATION_SYNC */
 #    endif     /* RGBLIGHT_USE_TIMER */
@@ -1124,13 +1170,16 @@ void rgblight_task(void) {
                 if (timer_expired(now, report_last_timer)) {
                     report_last_timer += 30000;
                     dprintf("rgblight animation tick report to slave\n");
+                    rgblight_status.animation_restart_timer = animation_status.last_timer;
                     RGBLIGHT_SPLIT_ANIMATION_TICK;
                 }
             }
             oldpos16 = animation_status.pos16;
 #    endif
             animation_status.last_timer += interval_time;
+            rgblight_defer_set = true;
             effect_func(&animation_status);
+            rgblight_defer_set = false;
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             if (animation_status.pos16 == 0 && oldpos16 != 0) {
                 tick_flag = true;
@@ -1139,6 +1188,11 @@ void rgblight_task(void) {
         }
     }
 
+    if (rgblight_frame_pending && sync_timer_elapsed(rgblight_frame_timer) >= RGBLIGHT_LED_FLUSH_LIMIT) {
+        rgblight_frame_timer = sync_timer_read();
+        rgblight_set();
+    }
+
 #    ifdef RGBLIGHT_LAYER_BLINK
     rgblight_blink_layer_repeat_helper();
 #    endif
@@ -118,6 +118,10 @@ enum RGBLIGHT_EFFECT_MODE {
 
 // sample: #define RGBLIGHT_EFFECT_BREATHE_CENTER   1.85
 
+#ifndef RGBLIGHT_LED_FLUSH_LIMIT
+#    define RGBLIGHT_LED_FLUSH_LIMIT 16 // limits in milliseconds how often animations write to the LEDs, 16 is about 60fps
+#endif
+
 #ifndef RGBLIGHT_EFFECT_BREATHE_MAX
 #    define RGBLIGHT_EFFECT_BREATHE_MAX 255 // 0-255
 #endif
@@ -254,6 +258,9 @@ typedef struct _rgblight_status_t {
 #ifdef RGBLIGHT_LAYERS
     rgblight_layer_mask_t enabled_layer_mask;
 #endif
+#if defined(RGBLIGHT_SPLIT) && defined(RGBLIGHT_USE_TIMER) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
+    uint16_t animation_restart_timer; // sync timer at which the master restarted the animation
+#endif
 } rgblight_status_t;
 
 /*
@@ -276,6 +283,7 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 
 /* === Low level Functions === */
 void rgblight_set(void);
+void rgblight_invalidate_frame(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
 
 /* === Effects and Animations Functions === */
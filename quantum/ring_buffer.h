@@ -1,48 +1,102 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
 #pragma once
 
-#include <util/atomic.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-#ifndef RBUF_SIZE
-#    define RBUF_SIZE 32
-#endif
+/* Single-producer/single-consumer ring buffer.
+ *
+ * RING_BUFFER_DECLARE(name, type, size) declares a static buffer holding up to
+ * (size - 1) elements of `type`, along with the following functions:
+ *
+ *   bool    name_enqueue(type item)   - producer; returns false when full
+ *   bool    name_dequeue(type *item)  - consumer; returns false when empty
+ *   bool    name_peek(type *item)     - consumer; like dequeue, without removal
+ *   bool    name_has_data(void)
+ *   uint8_t name_count(void)
+ *   void    name_clear(void)          - consumer; drops everything queued
+ *
+ * The head index is only written by the producer and the tail index only by
+ * the consumer, so one side may run in an interrupt handler and the other in
+ * the main loop without disabling interrupts.  Indices are single bytes, so
+ * `size` must be between 2 and 256.
+ */
 
-static uint8_t     rbuf[RBUF_SIZE];
-static uint8_t     rbuf_head = 0;
-static uint8_t     rbuf_tail = 0;
-static inline bool rbuf_enqueue(uint8_t data) {
-    bool ret = false;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        uint8_t next = (rbuf_head + 1) % RBUF_SIZE;
-        if (next != rbuf_tail) {
-            rbuf[rbuf_head] = data;
-            rbuf_head       = next;
-            ret             = true;
-        }
-    }
-    return ret;
-}
-static inline uint8_t rbuf_dequeue(void) {
-    uint8_t val = 0;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        if (rbuf_head != rbuf_tail) {
-            val       = rbuf[rbuf_tail];
-            rbuf_tail = (rbuf_tail + 1) % RBUF_SIZE;
-        }
-    }
+#define RING_BUFFER_BARRIER() __asm__ volatile("" ::: "memory")
+
+#ifdef __cplusplus
+#    define RING_BUFFER_STATIC_ASSERT static_assert
+#else
+#    define RING_BUFFER_STATIC_ASSERT _Static_assert
+#endif
 
-    return val;
-}
-static inline bool rbuf_has_data(void) {
-    bool has_data;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        has_data = (rbuf_head != rbuf_tail);
-    }
-    return has_data;
-}
-static inline void rbuf_clear(void) {
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        rbuf_head = rbuf_tail = 0;
-    }
-}
+#define RING_BUFFER_DECLARE(name, type, size)                                   \
+    static type             name##_buffer[(size)];                              \
+    static volatile uint8_t name##_head = 0;                                    \
+    static volatile uint8_t name##_tail = 0;                                    \
+                                                                                \
+    static inline uint8_t name##_next(uint8_t position) {                       \
+        return (position + 1 == (size)) ? 0 : position + 1;                     \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_enqueue(type item) {                              \
+        uint8_t head = name##_head;                                             \
+        uint8_t next = name##_next(head);                                       \
+        if (next == name##_tail) {                                              \
+            return false;                                                       \
+        }                                                                       \
+        name##_buffer[head] = item;                                             \
+        RING_BUFFER_BARRIER();                                                  \
+        name##_head = next;                                                     \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_peek(type *item) {                                \
+        uint8_t tail = name##_tail;                                             \
+        if (tail == name##_head) {                                              \
+            return false;                                                       \
+        }                                                                       \
+        RING_BUFFER_BARRIER();                                                  \
+        *item = name##_buffer[tail];                                            \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_dequeue(type *item) {                             \
+        if (!name##_peek(item)) {                                               \
+            return false;                                                       \
+        }                                                                       \
+        RING_BUFFER_BARRIER();                                                  \
+        name##_tail = name##_next(name##_tail);                                 \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_has_data(void) {                                  \
+        return name##_head != name##_tail;                                      \
+    }                                                                           \
+                                                                                \
+    static inline uint8_t name##_count(void) {                                  \
+        uint8_t head = name##_head;                                             \
+        uint8_t tail = name##_tail;                                             \
+        return (head >= tail) ? (head - tail) : ((size) + head - tail);         \
+    }                                                                           \
+                                                                                \
+    static inline void name##_clear(void) {                                     \
+        name##_tail = name##_head;                                              \
+    }                                                                           \
+                                                                                \
+    RING_BUFFER_STATIC_ASSERT((size) > 1 && (size) <= 256, #name " size must be between 2 and 256")
@@ -31,6 +31,10 @@
 #    include "rgblight.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 #ifndef SPLIT_USB_TIMEOUT
 #    define SPLIT_USB_TIMEOUT 2000
 #endif
@@ -181,6 +185,9 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
         if (connection_errors < UINT8_MAX) {
             connection_errors++;
         }
+#    ifdef TELEMETRY_ENABLE
+        telemetry_record(TELEMETRY_TRANSPORT_ERROR, &connection_errors, sizeof(connection_errors));
+#    endif
 #    if SPLIT_CONNECTION_CHECK_TIMEOUT > 0
         bool connected = is_transport_connected();
         if (!connected) {
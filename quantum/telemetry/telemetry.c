@@ -0,0 +1,215 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "telemetry.h"
+#include <stdarg.h>
+#include "raw_hid.h"
+#include "timer.h"
+
+_Static_assert((TELEMETRY_BUFFER_SIZE & (TELEMETRY_BUFFER_SIZE - 1)) == 0, "TELEMETRY_BUFFER_SIZE must be a power of two");
+_Static_assert(TELEMETRY_BUFFER_SIZE <= 32768, "TELEMETRY_BUFFER_SIZE must fit the 16 bit buffer indices");
+
+#define TELEMETRY_BUFFER_MASK (TELEMETRY_BUFFER_SIZE - 1)
+
+// Records are written at head and sent from tail, both only ever count up
+static uint8_t  buffer[TELEMETRY_BUFFER_SIZE];
+static uint16_t head, tail;
+static uint8_t  dropped;
+static uint8_t  sequence;
+static bool     listening;
+static uint32_t keepalive_timer;
+static uint16_t flush_timer;
+
+static uint16_t scan_timer, last_scan;
+static uint16_t scans, longest_scan;
+
+static inline void buffer_put(uint8_t value) {
+    buffer[head++ & TELEMETRY_BUFFER_MASK] = value;
+}
+
+static inline uint8_t buffer_peek(uint16_t offset) {
+    return buffer[(uint16_t)(tail + offset) & TELEMETRY_BUFFER_MASK];
+}
+
+/**
+ * @brief Handles a telemetry packet from the host
+ *
+ * Called by the USB protocol before raw_hid_receive(), which never sees telemetry packets.
+ *
+ * @param[in] data uint8_t* raw HID packet
+ * @param[in] length uint8_t packet length
+ * @return bool true if the packet was a telemetry packet, which is not answered
+ */
+bool telemetry_receive(uint8_t *data, uint8_t length) {
+    if (length < 2 || data[0] != TELEMETRY_PACKET_ID) {
+        return false;
+    }
+
+    if (data[1] == telemetry_start) {
+        if (!listening) {
+            head         = 0;
+            tail         = 0;
+            dropped      = 0;
+            sequence     = 0;
+            scans        = 0;
+            longest_scan = 0;
+            scan_timer   = timer_read();
+            last_scan    = scan_timer;
+            flush_timer  = scan_timer;
+            listening    = true;
+        }
+        keepalive_timer = timer_read32();
+    } else {
+        listening = false;
+    }
+    return true;
+}
+
+bool telemetry_is_listening(void) {
+    return listening;
+}
+
+/**
+ * @brief Buffers a record for the host
+ *
+ * Costs a single check while no host is listening. Records that do not fit the buffer are dropped and counted in the
+ * next packet. Must not be called from interrupts.
+ *
+ * @param[in] tag uint8_t one of telemetry_tag, or TELEMETRY_USER and up
+ * @param[in] payload void* payload, multi-byte values little endian
+ * @param[in] length uint8_t payload length, up to TELEMETRY_PAYLOAD_MAX
+ */
+void telemetry_record(uint8_t tag, const void *payload, uint8_t length) {
+    if (!listening) {
+        return;
+    }
+
+    if (length > TELEMETRY_PAYLOAD_MAX || TELEMETRY_BUFFER_SIZE - (uint16_t)(head - tail) < TELEMETRY_RECORD_HEADER_SIZE + length) {
+        if (dropped < UINT8_MAX) {
+            dropped++;
+        }
+        return;
+    }
+
+    uint16_t now = timer_read();
+    buffer_put(tag);
+    buffer_put(length);
+    buffer_put(now & 0xFF);
+    buffer_put(now >> 8);
+    for (uint8_t i = 0; i < length; i++) {
+        buffer_put(((const uint8_t *)payload)[i]);
+    }
+}
+
+/**
+ * @brief Buffers a trace statement, see trace.h
+ *
+ * @param[in] module uint8_t TRACE_MODULE_ID of the statement
+ * @param[in] file uint32_t TRACE_FILE_HASH of the source file, sent folded to 16 bits
+ * @param[in] line uint16_t source line of the statement
+ * @param[in] count uint8_t number of uint32_t arguments that follow, up to 5
+ */
+void telemetry_trace(uint8_t module, uint32_t file, uint16_t line, uint8_t count, ...) {
+    if (!listening) {
+        return;
+    }
+
+    uint16_t file_id                           = file ^ (file >> 16);
+    uint8_t  payload[5 + 5 * sizeof(uint32_t)] = {module, file_id & 0xFF, file_id >> 8, line & 0xFF, line >> 8};
+    uint8_t  length                            = 5;
+    va_list  args;
+
+    va_start(args, count);
+    for (uint8_t i = 0; i < count && i < 5; i++) {
+        uint32_t value    = va_arg(args, uint32_t);
+        payload[length++] = value & 0xFF;
+        payload[length++] = (value >> 8) & 0xFF;
+        payload[length++] = (value >> 16) & 0xFF;
+        payload[length++] = value >> 24;
+    }
+    va_end(args);
+    telemetry_record(TELEMETRY_TRACE, payload, length);
+}
+
+static void telemetry_scan(void) {
+    uint16_t now  = timer_read();
+    uint16_t scan = now - last_scan;
+
+    last_scan = now;
+    scans++;
+    if (scan > longest_scan) {
+        longest_scan = scan;
+    }
+
+    if (TIMER_DIFF_16(now, scan_timer) >= TELEMETRY_SCAN_INTERVAL) {
+        uint16_t payload[2] = {scans, longest_scan};
+        telemetry_record(TELEMETRY_SCAN, payload, sizeof(payload));
+        scan_timer   = now;
+        scans        = 0;
+        longest_scan = 0;
+    }
+}
+
+/**
+ * @brief Sends buffered records, called by QMK core once per scan
+ *
+ * Sends at most one packet per call, and only once a packet is full or the oldest record has waited
+ * TELEMETRY_FLUSH_INTERVAL. Records are only taken off the buffer once the endpoint accepted their
+ * packet, so that a busy host link neither stalls scanning nor loses records.
+ */
+void telemetry_task(void) {
+    if (!listening) {
+        return;
+    }
+    if (timer_elapsed32(keepalive_timer) > TELEMETRY_TIMEOUT) {
+        listening = false;
+        return;
+    }
+
+    telemetry_scan();
+
+    uint16_t used = head - tail;
+    if (used == 0 && dropped == 0) {
+        flush_timer = timer_read();
+        return;
+    }
+    if (used < TELEMETRY_PACKET_SIZE - 3 && timer_elapsed(flush_timer) < TELEMETRY_FLUSH_INTERVAL) {
+        return;
+    }
+
+    uint8_t  packet[TELEMETRY_PACKET_SIZE] = {TELEMETRY_PACKET_ID, sequence, dropped};
+    uint8_t  size                          = 3;
+    uint16_t taken                         = 0;
+    // only whole records go into a packet
+    while (taken != used) {
+        uint8_t record = TELEMETRY_RECORD_HEADER_SIZE + buffer_peek(taken + 1);
+        if (size + record > sizeof(packet)) {
+            break;
+        }
+        for (uint8_t i = 0; i < record; i++) {
+            packet[size++] = buffer_peek(taken + i);
+        }
+        taken += record;
+    }
+    if (!raw_hid_try_send(packet, sizeof(packet))) {
+        // the host has not read the previous packet yet, the records go out with the next try
+        return;
+    }
+    tail += taken;
+    sequence++;
+    dropped     = 0;
+    flush_timer = timer_read();
+}
@@ -0,0 +1,69 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bytes of records buffered between packets, must be a power of two
+#ifndef TELEMETRY_BUFFER_SIZE
+#    define TELEMETRY_BUFFER_SIZE 256
+#endif
+// Recording stops when the host has not sent a start packet for this long
+#ifndef TELEMETRY_TIMEOUT
+#    define TELEMETRY_TIMEOUT 3000
+#endif
+// Period of the scan statistics record
+#ifndef TELEMETRY_SCAN_INTERVAL
+#    define TELEMETRY_SCAN_INTERVAL 1000
+#endif
+// Longest time a record waits for a packet to be filled before it is sent anyway
+#ifndef TELEMETRY_FLUSH_INTERVAL
+#    define TELEMETRY_FLUSH_INTERVAL 10
+#endif
+
+// Raw HID packets, always 32 bytes
+//
+// host:     TELEMETRY_PACKET_ID, telemetry_start or telemetry_stop
+// keyboard: TELEMETRY_PACKET_ID, sequence, records dropped since the last packet, records...
+//
+// Each record is a tag, the payload length, the low 16 bits of timer_read() and the payload,
+// all multi-byte values little endian. A zero tag ends the records of a packet.
+#define TELEMETRY_PACKET_ID 0xFE
+#define TELEMETRY_PACKET_SIZE 32
+#define TELEMETRY_RECORD_HEADER_SIZE 4
+#define TELEMETRY_PAYLOAD_MAX (TELEMETRY_PACKET_SIZE - 3 - TELEMETRY_RECORD_HEADER_SIZE)
+
+enum telemetry_command {
+    telemetry_stop  = 0x00,
+    telemetry_start = 0x01, // also resent by the host to keep recording going
+};
+
+enum telemetry_tag {
+    TELEMETRY_SCAN            = 0x01, // scans (2), longest scan in ms (2)
+    TELEMETRY_LAYER           = 0x02, // layer state (4)
+    TELEMETRY_TRANSPORT_ERROR = 0x03, // consecutive split transport errors (1)
+    TELEMETRY_EEPROM_WRITE    = 0x04, // address (2), length (2)
+    TELEMETRY_TRACE           = 0x05, // module (1), file (2), line (2), up to 5 arguments (4 each), see trace.h
+    TELEMETRY_USER            = 0x80, // first tag free for keyboard and user records
+};
+
+bool telemetry_receive(uint8_t *data, uint8_t length);
+void telemetry_record(uint8_t tag, const void *payload, uint8_t length);
+void telemetry_trace(uint8_t module, uint32_t file, uint16_t line, uint8_t count, ...);
+bool telemetry_is_listening(void);
+void telemetry_task(void);
@@ -0,0 +1,7 @@
+telemetry_DEFS := -DTELEMETRY_ENABLE -DTELEMETRY_BUFFER_SIZE=64 -DTRACE_LEVEL_USER=TRACE_LEVEL_DEBUG
+telemetry_INC := $(QUANTUM_PATH)/telemetry
+
+telemetry_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/telemetry/tests/telemetry_tests.cpp \
+	$(QUANTUM_PATH)/telemetry/telemetry.c
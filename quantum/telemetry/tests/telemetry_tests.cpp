@@ -0,0 +1,201 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "telemetry.h"
+#include "trace.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+typedef std::vector<uint8_t> packet_t;
+
+std::vector<packet_t> packets;
+bool                  host_busy;
+
+extern "C" bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    if (host_busy) {
+        return false;
+    }
+    packets.push_back(packet_t(data, data + length));
+    return true;
+}
+
+static void send_command(uint8_t command) {
+    uint8_t data[TELEMETRY_PACKET_SIZE] = {TELEMETRY_PACKET_ID, command};
+    EXPECT_TRUE(telemetry_receive(data, sizeof(data)));
+}
+
+class Telemetry : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        send_command(telemetry_stop);
+        packets.clear();
+        host_busy = false;
+    }
+};
+
+TEST_F(Telemetry, IgnoresOtherPackets) {
+    uint8_t data[TELEMETRY_PACKET_SIZE] = {0x01};
+    EXPECT_FALSE(telemetry_receive(data, sizeof(data)));
+    EXPECT_FALSE(telemetry_is_listening());
+}
+
+TEST_F(Telemetry, RecordsNothingWithoutHost) {
+    uint8_t value = 1;
+    telemetry_record(TELEMETRY_USER, &value, sizeof(value));
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+    EXPECT_TRUE(packets.empty());
+}
+
+TEST_F(Telemetry, SendsRecordAfterFlushInterval) {
+    send_command(telemetry_start);
+    telemetry_task();
+
+    advance_time(2);
+    uint32_t layers = 0x12345678;
+    telemetry_record(TELEMETRY_LAYER, &layers, sizeof(layers));
+    telemetry_task();
+    EXPECT_TRUE(packets.empty());
+
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 1);
+
+    packet_t expected = {TELEMETRY_PACKET_ID, 0, 0, TELEMETRY_LAYER, 4, 2, 0, 0x78, 0x56, 0x34, 0x12};
+    expected.resize(TELEMETRY_PACKET_SIZE);
+    EXPECT_EQ(packets[0], expected);
+}
+
+TEST_F(Telemetry, SendsFullPacketsRightAway) {
+    send_command(telemetry_start);
+
+    uint8_t payload[10] = {0};
+    for (int i = 0; i < 3; i++) {
+        telemetry_record(TELEMETRY_USER, payload, sizeof(payload));
+    }
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 1);
+    // two records fit, the third waits for the next packet
+    EXPECT_EQ(packets[0][3 + 14], TELEMETRY_USER);
+    EXPECT_EQ(packets[0][3 + 28], 0);
+
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 2);
+    EXPECT_EQ(packets[1][1], 1);
+    EXPECT_EQ(packets[1][3], TELEMETRY_USER);
+    EXPECT_EQ(packets[1][3 + 14], 0);
+}
+
+TEST_F(Telemetry, KeepsRecordsWhileHostIsBusy) {
+    send_command(telemetry_start);
+
+    uint8_t value = 1;
+    telemetry_record(TELEMETRY_USER, &value, sizeof(value));
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    host_busy = true;
+    telemetry_task();
+    value = 2;
+    telemetry_record(TELEMETRY_USER, &value, sizeof(value));
+    advance_time(1);
+    telemetry_task();
+    EXPECT_TRUE(packets.empty());
+
+    host_busy = false;
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 1);
+    // the first packet still has sequence number 0 and carries both records
+    EXPECT_EQ(packets[0][1], 0);
+    EXPECT_EQ(packets[0][3 + 4], 1);
+    EXPECT_EQ(packets[0][3 + 5 + 4], 2);
+}
+
+TEST_F(Telemetry, CountsDroppedRecords) {
+    send_command(telemetry_start);
+
+    uint8_t payload[12] = {0};
+    for (int i = 0; i < 6; i++) {
+        telemetry_record(TELEMETRY_USER, payload, sizeof(payload));
+    }
+    telemetry_record(TELEMETRY_USER, payload, TELEMETRY_PAYLOAD_MAX + 1);
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 1);
+    // 64 bytes hold four records of 16 bytes
+    EXPECT_EQ(packets[0][2], 3);
+}
+
+TEST_F(Telemetry, ReportsScanRate) {
+    send_command(telemetry_start);
+    for (int i = 0; i < TELEMETRY_SCAN_INTERVAL / 2; i++) {
+        advance_time(i == 100 ? 5 : 2);
+        if (i % 500 == 0) {
+            send_command(telemetry_start);
+        }
+        telemetry_task();
+    }
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0][3], TELEMETRY_SCAN);
+    EXPECT_EQ(packets[0][4], 4);
+    uint16_t scans   = packets[0][7] | packets[0][8] << 8;
+    uint16_t longest = packets[0][9] | packets[0][10] << 8;
+    EXPECT_GE(scans, TELEMETRY_SCAN_INTERVAL / 2 - 2);
+    EXPECT_EQ(longest, 5);
+}
+
+TEST_F(Telemetry, StopsWithoutKeepalive) {
+    send_command(telemetry_start);
+    advance_time(TELEMETRY_TIMEOUT + 1);
+    telemetry_task();
+    EXPECT_FALSE(telemetry_is_listening());
+
+    uint8_t value = 1;
+    telemetry_record(TELEMETRY_USER, &value, sizeof(value));
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+    EXPECT_TRUE(packets.empty());
+}
+
+TEST_F(Telemetry, SendsTraceArgumentsOnly) {
+    send_command(telemetry_start);
+
+    int8_t value = -2;
+    trace_debug("value %d of %u", value, 300);
+    trace_verbose("not compiled in %u", 1);
+    trace_info("no arguments");
+    advance_time(TELEMETRY_FLUSH_INTERVAL);
+    telemetry_task();
+    ASSERT_EQ(packets.size(), 1);
+
+    uint16_t line = __LINE__ - 7;
+    // what `qmk telemetry` computes for quantum/telemetry/tests/telemetry_tests.cpp
+    uint16_t file     = 0xC286;
+    packet_t expected = {TELEMETRY_PACKET_ID, 0, 0};
+    for (auto record : {packet_t{TELEMETRY_TRACE, 13, 0, 0, TRACE_MODULE_ID_USER, (uint8_t)file, (uint8_t)(file >> 8), (uint8_t)line, (uint8_t)(line >> 8), 0xFE, 0xFF, 0xFF, 0xFF, 0x2C, 0x01, 0, 0}, packet_t{TELEMETRY_TRACE, 5, 0, 0, TRACE_MODULE_ID_USER, (uint8_t)file, (uint8_t)(file >> 8), (uint8_t)(line + 2), (uint8_t)((line + 2) >> 8)}}) {
+        expected.insert(expected.end(), record.begin(), record.end());
+    }
+    expected.resize(TELEMETRY_PACKET_SIZE);
+    EXPECT_EQ(packets[0], expected);
+}
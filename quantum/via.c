@@ -184,6 +184,189 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
+// Bulk transfers, see via.h for the packets.
+// Data packets carry what is left of a VIA packet after the command ID and sequence.
+#define VIA_BULK_PACKET_SIZE 32
+#define VIA_BULK_DATA_SIZE (VIA_BULK_PACKET_SIZE - 3)
+
+#ifndef MIN
+#    define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+// A transfer is dropped once the other side made no progress for this many ms
+#ifndef VIA_BULK_TIMEOUT
+#    define VIA_BULK_TIMEOUT 1000
+#endif
+
+static struct {
+    uint8_t  space; // 0 when no transfer is running
+    bool     writing;
+    bool     failed;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t done;
+    uint16_t sequence;
+    uint16_t crc;
+    uint16_t timer; // last progress
+} via_bulk;
+
+// CRC-16/CCITT-FALSE, the table-less version is fast enough for the few kB of a keymap
+static uint16_t via_bulk_crc(uint16_t crc, const uint8_t *data, uint8_t size) {
+    while (size--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t via_bulk_space_size(uint8_t space) {
+    switch (space) {
+        case id_bulk_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_macro:
+            return dynamic_keymap_macro_get_buffer_size();
+        case id_bulk_custom_config:
+            return VIA_EEPROM_CUSTOM_CONFIG_SIZE;
+        default:
+            return 0;
+    }
+}
+
+static void via_bulk_access(bool write, uint16_t offset, uint8_t size, uint8_t *data) {
+    switch (via_bulk.space) {
+        case id_bulk_keymap:
+            if (write) {
+                dynamic_keymap_set_buffer(offset, size, data);
+            } else {
+                dynamic_keymap_get_buffer(offset, size, data);
+            }
+            break;
+        case id_bulk_macro:
+            if (write) {
+                dynamic_keymap_macro_set_buffer(offset, size, data);
+            } else {
+                dynamic_keymap_macro_get_buffer(offset, size, data);
+            }
+            break;
+        case id_bulk_custom_config:
+            for (uint8_t i = 0; i < size; i++) {
+                void *address = (void *)VIA_EEPROM_CUSTOM_CONFIG_ADDR + offset + i;
+                if (write) {
+                    eeprom_update_byte(address, data[i]);
+                } else {
+                    data[i] = eeprom_read_byte(address);
+                }
+            }
+            break;
+    }
+}
+
+static void via_bulk_start(uint8_t *command_data, bool writing) {
+    uint8_t  space  = command_data[0];
+    uint16_t offset = (command_data[1] << 8) | command_data[2];
+    uint16_t size   = (command_data[3] << 8) | command_data[4];
+
+    // a new request always cancels a transfer that is still running
+    via_bulk.space = 0;
+    if (size == 0 || (uint32_t)offset + size > via_bulk_space_size(space)) {
+        command_data[5] = id_bulk_bad_range;
+        return;
+    }
+
+    via_bulk.space    = space;
+    via_bulk.writing  = writing;
+    via_bulk.failed   = false;
+    via_bulk.offset   = offset;
+    via_bulk.size     = size;
+    via_bulk.done     = 0;
+    via_bulk.sequence = 0;
+    via_bulk.crc      = 0xFFFF;
+    via_bulk.timer    = timer_read();
+    command_data[5]   = id_bulk_ok;
+}
+
+static void via_bulk_receive(uint8_t *command_data) {
+    if (via_bulk.space == 0 || !via_bulk.writing) {
+        return;
+    }
+
+    uint16_t sequence = (command_data[0] << 8) | command_data[1];
+    if (sequence != via_bulk.sequence) {
+        // a packet got lost, the CRC check at the end reports the failure
+        via_bulk.failed = true;
+        return;
+    }
+
+    uint8_t size = MIN(VIA_BULK_DATA_SIZE, via_bulk.size - via_bulk.done);
+    via_bulk_access(true, via_bulk.offset + via_bulk.done, size, &command_data[2]);
+    via_bulk.done += size;
+    via_bulk.sequence++;
+    via_bulk.timer = timer_read();
+}
+
+static void via_bulk_finish(uint8_t *command_data) {
+    uint16_t expected = (command_data[0] << 8) | command_data[1];
+    bool     valid    = via_bulk.space != 0 && via_bulk.writing && !via_bulk.failed && via_bulk.done == via_bulk.size;
+
+    if (valid) {
+        // check what ended up in the EEPROM rather than what was received
+        uint8_t  buffer[VIA_BULK_DATA_SIZE];
+        uint16_t crc = 0xFFFF;
+        for (uint16_t done = 0; done < via_bulk.size; done += VIA_BULK_DATA_SIZE) {
+            uint8_t size = MIN(VIA_BULK_DATA_SIZE, via_bulk.size - done);
+            via_bulk_access(false, via_bulk.offset + done, size, buffer);
+            crc = via_bulk_crc(crc, buffer, size);
+        }
+        valid = crc == expected;
+    }
+    command_data[2] = valid ? id_bulk_ok : id_bulk_bad_data;
+    via_bulk.space  = 0;
+}
+
+// Called by QMK core to send the packets of a bulk read. A packet is only
+// sent once the endpoint is free, so a host that reads slowly holds up the
+// transfer rather than the scan, and one that stops reading cancels it.
+void via_task(void) {
+    if (via_bulk.space == 0) {
+        return;
+    }
+    if (timer_elapsed(via_bulk.timer) > VIA_BULK_TIMEOUT) {
+        via_bulk.space = 0;
+        return;
+    }
+    if (via_bulk.writing) {
+        return;
+    }
+
+    uint8_t data[VIA_BULK_PACKET_SIZE] = {0};
+    uint8_t size                       = MIN(VIA_BULK_DATA_SIZE, via_bulk.size - via_bulk.done);
+    if (size) {
+        data[0] = id_bulk_data;
+        data[1] = via_bulk.sequence >> 8;
+        data[2] = via_bulk.sequence & 0xFF;
+        via_bulk_access(false, via_bulk.offset + via_bulk.done, size, &data[3]);
+    } else {
+        data[0] = id_bulk_end;
+        data[1] = via_bulk.crc >> 8;
+        data[2] = via_bulk.crc & 0xFF;
+    }
+    if (!raw_hid_try_send(data, sizeof(data))) {
+        // the same packet is built again on the next call
+        return;
+    }
+
+    if (size) {
+        via_bulk.crc = via_bulk_crc(via_bulk.crc, &data[3], size);
+        via_bulk.done += size;
+        via_bulk.sequence++;
+        via_bulk.timer = timer_read();
+    } else {
+        via_bulk.space = 0;
+    }
+}
+
 // Keyboard level code can override this to handle custom messages from VIA.
 // See raw_hid_receive() implementation.
 // DO NOT call raw_hid_send() in the override function.
@@ -377,6 +560,20 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+        case id_bulk_read:
+        case id_bulk_write: {
+            via_bulk_start(command_data, *command_id == id_bulk_write);
+            break;
+        }
+        case id_bulk_data: {
+            // The host sends these back to back, they are not answered
+            via_bulk_receive(command_data);
+            return;
+        }
+        case id_bulk_end: {
+            via_bulk_finish(command_data);
+            break;
+        }
         default: {
             // The command ID is not known
             // Return the unhandled state
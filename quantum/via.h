@@ -78,9 +78,40 @@ enum via_command_id {
     id_dynamic_keymap_get_layer_count       = 0x11,
     id_dynamic_keymap_get_buffer            = 0x12,
     id_dynamic_keymap_set_buffer            = 0x13,
+    id_bulk_read                            = 0x30,
+    id_bulk_write                           = 0x31,
+    id_bulk_data                            = 0x32,
+    id_bulk_end                             = 0x33,
     id_unhandled                            = 0xFF,
 };
 
+// Bulk transfers move a whole range of one of these in a single exchange:
+//
+// host:     id_bulk_read, space, offset (2), size (2)
+// keyboard: the same, followed by a status byte
+// keyboard: id_bulk_data, sequence (2), up to 29 bytes, repeated until size bytes were sent
+// keyboard: id_bulk_end, CRC-16/CCITT-FALSE of the range (2)
+//
+// host:     id_bulk_write, space, offset (2), size (2)
+// keyboard: the same, followed by a status byte
+// host:     id_bulk_data, sequence (2), up to 29 bytes, repeated without waiting for replies
+// host:     id_bulk_end, CRC-16/CCITT-FALSE of the range (2)
+// keyboard: the same, followed by a status byte, after checking the CRC of what was stored
+//
+// All values are big endian, the sequence starts at 0 for every transfer.
+// A transfer that makes no progress for VIA_BULK_TIMEOUT ms is cancelled.
+enum via_bulk_space_id {
+    id_bulk_keymap        = 0x01,
+    id_bulk_macro         = 0x02,
+    id_bulk_custom_config = 0x03,
+};
+
+enum via_bulk_status {
+    id_bulk_ok        = 0x00,
+    id_bulk_bad_range = 0x01,
+    id_bulk_bad_data  = 0x02,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01, //
     id_layout_options      = 0x02,
@@ -155,6 +186,8 @@ void via_eeprom_set_valid(bool valid);
 // Called by QMK core to initialize dynamic keymaps etc.
 void eeconfig_init_via(void);
 void via_init(void);
+// Called by QMK core to send the packets of a bulk read
+void via_task(void);
 
 // Used by VIA to store and retrieve the layout options.
 uint32_t via_get_layout_options(void);
@@ -17,7 +17,7 @@
 
 #include "wpm.h"
 
-#include <math.h>
+#include <string.h>
 
 // WPM Stuff
 static uint8_t  current_wpm = 0;
@@ -31,13 +31,27 @@ static uint32_t wpm_timer   = 0;
  * of the ring buffer can be configured using the keymap configuration
  * value `WPM_SAMPLE_PERIODS`.
  *
+ * The sum over the ring buffer is kept up to date as keys are pressed and
+ * periods roll over, and the estimate is only recalculated on those events,
+ * using a fixed-point scale factor rather than a division.  When idle, the
+ * per-loop cost of decay_wpm() is little more than a timer comparison.
  */
 #define MAX_PERIODS (WPM_SAMPLE_PERIODS)
 #define PERIOD_DURATION (1000 * WPM_SAMPLE_SECONDS / MAX_PERIODS)
 
 static int16_t period_presses[MAX_PERIODS] = {0};
+static int32_t presses_sum                 = 0;
 static uint8_t current_period              = 0;
 static uint8_t periods                     = 1;
+static uint8_t target_wpm                  = 0;
+static bool    wpm_dirty                   = false;
+
+/* WPM contributed by a single keypress in the ring buffer, in Q8 fixed point.
+ * It only depends on the number of periods in use, so it is refreshed when
+ * that changes instead of on every calculation.
+ */
+static uint32_t wpm_scale         = 0;
+static uint8_t  wpm_scale_periods = UINT8_MAX;
 
 #if !defined(WPM_UNFILTERED)
 /* LATENCY is used as part of filtering, and controls how quickly the reported
@@ -50,11 +64,23 @@ static uint8_t periods                     = 1;
  * LATENCY is not used if WPM_UNFILTERED is defined.
  */
 #    define LATENCY (100)
+#    define LATENCY_RECIPROCAL ((65536 + LATENCY - 1) / LATENCY)
 static uint32_t smoothing_timer = 0;
 static uint8_t  prev_wpm        = 0;
 static uint8_t  next_wpm        = 0;
 #endif
 
+#if defined(WPM_HISTORY_LENGTH)
+_Static_assert(WPM_HISTORY_LENGTH > 0 && WPM_HISTORY_LENGTH <= 255, "WPM_HISTORY_LENGTH must be between 1 and 255");
+
+/* Reported WPM sampled once a second, for graphs and the like.  Sampling is
+ * driven by the period rollover, so no extra timer is needed.
+ */
+static uint8_t  wpm_history[WPM_HISTORY_LENGTH] = {0};
+static uint8_t  wpm_history_head                = 0;
+static uint16_t wpm_history_elapsed             = 0;
+#endif
+
 void set_current_wpm(uint8_t new_wpm) {
     current_wpm = new_wpm;
 }
@@ -109,67 +135,109 @@ __attribute__((weak)) uint8_t wpm_regress_count(uint16_t keycode) {
 void update_wpm(uint16_t keycode) {
     if (wpm_keycode(keycode) && period_presses[current_period] < INT16_MAX) {
         period_presses[current_period]++;
+        presses_sum++;
+        wpm_dirty = true;
     }
 #if defined(WPM_ALLOW_COUNT_REGRESSION)
     uint8_t regress = wpm_regress_count(keycode);
     if (regress && period_presses[current_period] > INT16_MIN) {
         period_presses[current_period]--;
+        presses_sum--;
+        wpm_dirty = true;
     }
 #endif
 }
 
-void decay_wpm(void) {
-    int32_t presses = period_presses[0];
-    for (int i = 1; i <= periods; i++) {
-        presses += period_presses[i];
+static uint8_t calculate_wpm(void) {
+    if (presses_sum < 2) { // don't guess high WPM based on a single keypress.
+        return 0;
     }
-    if (presses < 0) {
-        presses = 0;
+
+    if (periods != wpm_scale_periods) {
+        // The current period is on average half over, count it as such.
+        uint32_t duration = ((uint32_t)periods * PERIOD_DURATION) + (PERIOD_DURATION / 2);
+        wpm_scale         = (60000UL << 8) / (duration * WPM_ESTIMATED_WORD_SIZE);
+        wpm_scale_periods = periods;
     }
-    int32_t  elapsed  = timer_elapsed32(wpm_timer);
-    uint32_t duration = (((periods)*PERIOD_DURATION) + elapsed);
-    int32_t  wpm_now  = (60000 * presses) / (duration * WPM_ESTIMATED_WORD_SIZE);
 
-    if (wpm_now < 0) // set some reasonable WPM measurement limits
-        wpm_now = 0;
-    if (wpm_now > 240) wpm_now = 240;
+    uint32_t presses = (presses_sum > UINT16_MAX) ? UINT16_MAX : presses_sum;
+    uint32_t wpm_now = (presses * wpm_scale) >> 8;
+
+    // set some reasonable WPM measurement limits
+    return (wpm_now > 240) ? 240 : wpm_now;
+}
 
-    if (elapsed > PERIOD_DURATION) {
-        current_period                 = (current_period + 1) % MAX_PERIODS;
+#if defined(WPM_HISTORY_LENGTH)
+static void update_wpm_history(void) {
+    wpm_history_elapsed += PERIOD_DURATION;
+    if (wpm_history_elapsed >= 1000) {
+        wpm_history_elapsed -= 1000;
+        wpm_history_head              = (wpm_history_head + 1) % WPM_HISTORY_LENGTH;
+        wpm_history[wpm_history_head] = current_wpm;
+    }
+}
+
+uint8_t get_wpm_history(uint8_t seconds_ago) {
+    if (seconds_ago >= WPM_HISTORY_LENGTH) {
+        return 0;
+    }
+    return wpm_history[(wpm_history_head + WPM_HISTORY_LENGTH - seconds_ago) % WPM_HISTORY_LENGTH];
+}
+#endif
+
+void decay_wpm(void) {
+    if (timer_elapsed32(wpm_timer) > PERIOD_DURATION) {
+        current_period = (current_period + 1) % MAX_PERIODS;
+        presses_sum -= period_presses[current_period];
         period_presses[current_period] = 0;
         periods                        = (periods < MAX_PERIODS - 1) ? periods + 1 : MAX_PERIODS - 1;
-        elapsed                        = 0;
         wpm_timer                      = timer_read32();
+        wpm_dirty                      = true;
+#if defined(WPM_HISTORY_LENGTH)
+        update_wpm_history();
+#endif
     }
-    if (presses < 2) // don't guess high WPM based on a single keypress.
-        wpm_now = 0;
+
+    if (wpm_dirty) {
+        wpm_dirty = false;
 
 #if defined(WPM_LAUNCH_CONTROL)
-    /*
-     * If the `WPM_LAUNCH_CONTROL` option is enabled, then whenever our WPM
-     * drops to absolute zero due to no typing occurring within our sample
-     * ring buffer, we reset and start measuring fresh, which lets our WPM
-     * immediately reach the correct value even before a full sampling buffer
-     * has been filled.
-     */
-    if (presses == 0) {
-        current_period    = 0;
-        periods           = 0;
-        wpm_now           = 0;
-        period_presses[0] = 0;
-    }
+        /*
+         * If the `WPM_LAUNCH_CONTROL` option is enabled, then whenever our WPM
+         * drops to absolute zero due to no typing occurring within our sample
+         * ring buffer, we reset and start measuring fresh, which lets our WPM
+         * immediately reach the correct value even before a full sampling buffer
+         * has been filled.
+         */
+        if (presses_sum <= 0 && periods != 0) {
+            memset(period_presses, 0, sizeof(period_presses));
+            presses_sum    = 0;
+            current_period = 0;
+            periods        = 0;
+        }
 #endif // WPM_LAUNCH_CONTROL
 
+        target_wpm = calculate_wpm();
+    }
+
 #if defined(WPM_UNFILTERED)
-    current_wpm = wpm_now;
+    current_wpm = target_wpm;
 #else
-    int32_t latency = timer_elapsed32(smoothing_timer);
+    uint32_t latency = timer_elapsed32(smoothing_timer);
     if (latency > LATENCY) {
+        if (current_wpm == target_wpm) {
+            return;
+        }
         smoothing_timer = timer_read32();
         prev_wpm        = current_wpm;
-        next_wpm        = wpm_now;
+        next_wpm        = target_wpm;
+        latency         = 0;
     }
 
-    current_wpm = prev_wpm + (latency * ((int)next_wpm - (int)prev_wpm) / LATENCY);
+    if (next_wpm >= prev_wpm) {
+        current_wpm = prev_wpm + ((latency * (next_wpm - prev_wpm) * LATENCY_RECIPROCAL) >> 16);
+    } else {
+        current_wpm = prev_wpm - ((latency * (prev_wpm - next_wpm) * LATENCY_RECIPROCAL) >> 16);
+    }
 #endif
 }
@@ -42,3 +42,7 @@ uint8_t get_current_wpm(void);
 void    update_wpm(uint16_t);
 
 void decay_wpm(void);
+
+#ifdef WPM_HISTORY_LENGTH
+uint8_t get_wpm_history(uint8_t seconds_ago);
+#endif
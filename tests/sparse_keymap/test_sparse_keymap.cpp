@@ -0,0 +1,71 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keymap.h"
+}
+
+// clang-format off
+
+/* The keymap as keymaps[][][] would hold it: gaps, an empty row, a full row
+ * and keys in the last column, plus a KC_NO that layer 1 has to store. */
+static const uint16_t dense_keymap[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_Q,  KC_W,  KC_NO, KC_E,  KC_NO, KC_NO, KC_T,  KC_NO, KC_NO, KC_P   },
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO  },
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_ENT },
+        {KC_A,  KC_S,  KC_D,  KC_F,  KC_G,  KC_H,  KC_J,  KC_K,  KC_L,  KC_SCLN},
+    },
+    [1] = {
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_1,    KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_NO,   KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TAB },
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+    },
+};
+
+/* The same keymap as `qmk json2c --sparse` writes it. */
+const matrix_row_t sparse_keymap_masks[][MATRIX_ROWS] = {
+    [0] = {0x24B, 0x000, 0x200, 0x3FF},
+    [1] = {0x010, 0x000, 0x204, 0x000},
+};
+
+const uint16_t sparse_keymap_offsets[][MATRIX_ROWS] = {
+    [0] = {0, 5, 5, 6},
+    [1] = {16, 17, 17, 19},
+};
+
+const uint16_t sparse_keymap_keycodes[] = {
+    KC_Q, KC_W, KC_E, KC_T, KC_P, KC_ENT, KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN,
+    KC_1, KC_NO, KC_TAB,
+};
+
+// clang-format on
+
+class SparseKeymap : public TestFixture {};
+
+TEST_F(SparseKeymap, ReadsLikeDenseKeymap) {
+    for (uint8_t layer = 0; layer < sizeof(dense_keymap) / sizeof(dense_keymap[0]); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(keymap_flash_keycode(layer, row, col), dense_keymap[layer][row][col]) << "layer " << +layer << " row " << +row << " col " << +col;
+            }
+        }
+    }
+}
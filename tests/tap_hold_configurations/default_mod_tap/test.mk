@@ -15,4 +15,5 @@
 
 # --------------------------------------------------------------------------------
 # Keep this file, even if it is empty, as a marker that this folder contains tests
-# --------------------------------------------------------------------------------
\ No newline at end of file
+# --------------------------------------------------------------------------------
+include tests/tap_hold_configurations/replay.mk
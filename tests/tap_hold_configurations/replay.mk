@@ -0,0 +1,24 @@
+# Copyright 2021 QMK
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Replays typing.log through the configuration of the including test and
+# compares the reports against its replay.expected transcript. TestReplay
+# observes key presses through process_record_kb(), so suites that include
+# this must not define it themselves.
+SRC += \
+	tests/test_common/test_replay.cpp \
+	tests/tap_hold_configurations/test_replay_typing_log.cpp
+
+OPT_DEFS += -DREPLAY_EXPECTED=\"$(TEST_PATH)/replay.expected\"
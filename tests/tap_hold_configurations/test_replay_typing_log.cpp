@@ -0,0 +1,68 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Built into every tap-hold configuration that includes replay.mk, so that
+ * their expected transcripts can be diffed against each other directly. */
+
+#include <cstdlib>
+#include <iostream>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_replay.hpp"
+#include "action_tapping.h"
+
+#define REPLAY_LOG "tests/tap_hold_configurations/typing.log"
+
+class TapHoldReplay : public TestFixture {
+   protected:
+    void set_replay_keymap() {
+        const uint16_t base[4][MATRIX_COLS] = {
+            {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+            {KC_A, LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), RALT_T(KC_L), KC_SCLN},
+            {KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+            {KC_NO, KC_NO, KC_NO, KC_NO, LT(1, KC_SPC), KC_ENT, KC_NO, KC_NO, KC_NO, KC_NO},
+        };
+        const uint16_t numbers[MATRIX_COLS] = {KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0};
+
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, base[row][col]));
+                add_key(KeymapKey(1, col, row, row == 0 ? numbers[col] : KC_TRNS));
+            }
+        }
+    }
+};
+
+/* Replays REPLAY_LOG, or the log named by QMK_REPLAY_LOG, and checks the
+ * resulting reports against the transcript of this configuration. */
+TEST_F(TapHoldReplay, replay_typing_log) {
+    TestDriver  driver;
+    TestReplay  replay(*this, driver);
+    const char* log = std::getenv("QMK_REPLAY_LOG");
+
+    set_replay_keymap();
+    replay.run(TestReplay::load(log ? log : REPLAY_LOG));
+    if (!log) {
+        replay.expect_transcript(REPLAY_EXPECTED);
+    }
+
+    std::cout << "[  REPLAY  ] " << replay.summary() << std::endl;
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_GT(replay.stats().decisions, 0);
+    /* No key press may be held back by the tapping engine for longer than the tapping term. */
+    EXPECT_LE(replay.stats().latency_max, TAPPING_TERM + 1);
+}
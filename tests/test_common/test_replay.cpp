@@ -0,0 +1,198 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_replay.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_logger.hpp"
+#include "test_matrix.h"
+
+extern "C" {
+#include "action.h"
+#include "quantum.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::Invoke;
+
+/* Gaps longer than this with no keys held are skipped by advancing the timer
+ * instead of scanning every millisecond, which keeps multi-hour logs fast. */
+#define REPLAY_IDLE_SCANS (TAPPING_TERM * 10)
+
+TestReplay* TestReplay::m_this = nullptr;
+
+namespace {
+const uint32_t NOT_PRESSED = UINT32_MAX;
+uint32_t       pressed_at[MATRIX_ROWS][MATRIX_COLS];
+unsigned       keys_held = 0;
+} // namespace
+
+/* Override weak QMK function to observe when the tapping engine releases a key
+ * press for processing. This file is only linked into suites that opt into
+ * replays, see tests/tap_hold_configurations/replay.mk. */
+extern "C" bool process_record_kb(uint16_t keycode, keyrecord_t* record) {
+    if (TestReplay::m_this && record->event.pressed && !IS_NOEVENT(record->event)) {
+        keypos_t key = record->event.key;
+        if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS && pressed_at[key.row][key.col] != NOT_PRESSED) {
+            TestReplay::m_this->record_decision(timer_read32() - pressed_at[key.row][key.col]);
+            pressed_at[key.row][key.col] = NOT_PRESSED;
+        }
+    }
+    return process_record_user(keycode, record);
+}
+
+TestReplay::TestReplay(TestFixture& fixture, TestDriver& driver) : m_fixture(fixture), m_start(timer_read32()) {
+    m_this = this;
+    keys_held = 0;
+    std::fill(&pressed_at[0][0], &pressed_at[0][0] + MATRIX_ROWS * MATRIX_COLS, NOT_PRESSED);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t& report) { record_report(report); }));
+}
+
+TestReplay::~TestReplay() {
+    m_this = nullptr;
+}
+
+std::vector<ReplayEvent> TestReplay::load(const std::string& path) {
+    std::vector<ReplayEvent> events;
+    std::ifstream            file(path);
+    if (!file) {
+        ADD_FAILURE() << "Unable to open replay log " << path;
+        return events;
+    }
+
+    std::string line;
+    unsigned    line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           col, row;
+        char               state;
+        if (!(fields >> time >> col >> row >> state) || col >= MATRIX_COLS || row >= MATRIX_ROWS || (state != 'd' && state != 'u') || (!events.empty() && time < events.back().time)) {
+            ADD_FAILURE() << path << ":" << line_number << ": malformed replay event '" << line << "'";
+            continue;
+        }
+        events.push_back({time, (uint8_t)col, (uint8_t)row, state == 'd'});
+    }
+    return events;
+}
+
+void TestReplay::scan_until(uint32_t time) {
+    uint32_t target = m_start + time;
+    uint32_t now    = timer_read32();
+
+    if (keys_held == 0 && target - now > REPLAY_IDLE_SCANS) {
+        m_fixture.idle_for(REPLAY_IDLE_SCANS);
+        now = timer_read32();
+        advance_time(target - now);
+    }
+
+    while (timer_read32() < target) {
+        m_fixture.run_one_scan_loop();
+    }
+}
+
+void TestReplay::run(const std::vector<ReplayEvent>& events) {
+    auto started = std::chrono::steady_clock::now();
+
+    for (auto& event : events) {
+        scan_until(event.time);
+        if (event.pressed) {
+            press_key(event.col, event.row);
+            pressed_at[event.row][event.col] = timer_read32();
+            keys_held++;
+        } else {
+            release_key(event.col, event.row);
+            keys_held--;
+        }
+        m_fixture.run_one_scan_loop();
+        m_stats.events++;
+    }
+    /* Let every pending decision resolve before the transcript is inspected. */
+    m_fixture.idle_for(TAPPING_TERM * 2);
+
+    m_stats.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+void TestReplay::record_report(const report_keyboard_t& report) {
+    std::ostringstream line;
+    line << (timer_read32() - m_start) << " " << report;
+
+    std::string text = line.str();
+    text.erase(text.find_last_not_of('\n') + 1);
+    m_transcript.push_back(text);
+    m_stats.reports++;
+}
+
+void TestReplay::record_decision(uint16_t latency) {
+    m_stats.decisions++;
+    m_stats.latency_sum += latency;
+    if (latency > m_stats.latency_max) {
+        m_stats.latency_max = latency;
+    }
+}
+
+std::string TestReplay::summary() const {
+    std::ostringstream text;
+    text << m_stats.events << " events, " << m_stats.reports << " reports, decision latency mean " << m_stats.latency_mean() << " ms max " << m_stats.latency_max << " ms, " << (uint64_t)m_stats.events_per_second() << " events/s";
+    return text.str();
+}
+
+void TestReplay::expect_transcript(const std::string& path) const {
+    if (std::getenv("QMK_REPLAY_UPDATE")) {
+        std::ofstream file(path);
+        for (auto& line : m_transcript) {
+            file << line << "\n";
+        }
+        return;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        ADD_FAILURE() << "Unable to open expected transcript " << path << ", run with QMK_REPLAY_UPDATE=1 to create it";
+        return;
+    }
+
+    std::string line;
+    size_t      index = 0;
+    while (std::getline(file, line)) {
+        if (index >= m_transcript.size()) {
+            ADD_FAILURE() << path << ":" << index + 1 << ": expected '" << line << "' but the replay sent no further reports";
+            return;
+        }
+        if (line != m_transcript[index]) {
+            ADD_FAILURE() << path << ":" << index + 1 << ": expected '" << line << "' but got '" << m_transcript[index] << "'";
+            return;
+        }
+        index++;
+    }
+    if (index != m_transcript.size()) {
+        ADD_FAILURE() << path << ": replay sent " << m_transcript.size() - index << " unexpected trailing reports, first '" << m_transcript[index] << "'";
+    }
+}
@@ -0,0 +1,86 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+/* A single matrix transition of a recorded typing log. */
+struct ReplayEvent {
+    uint32_t time;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+struct ReplayStats {
+    size_t   events       = 0;
+    size_t   reports      = 0;
+    size_t   decisions    = 0;
+    uint64_t latency_sum  = 0;
+    uint16_t latency_max  = 0;
+    double   wall_seconds = 0;
+
+    double latency_mean() const { return decisions ? (double)latency_sum / decisions : 0; }
+    double events_per_second() const { return wall_seconds > 0 ? events / wall_seconds : 0; }
+};
+
+/* Feeds a recorded typing log through the test fixture in virtual time.
+ *
+ * Every keyboard report is appended to a transcript stamped with the virtual
+ * time it was sent at, so two configurations replaying the same log can be
+ * compared line by line. Decision latency is measured for every key press as
+ * the time between the matrix transition and the moment the event leaves the
+ * tapping engine and reaches process_record_kb().
+ *
+ * The log format is one event per line, `<time ms> <col> <row> <d|u>`, with
+ * `#` starting a comment. Times are relative to the start of the replay and
+ * must not decrease.
+ */
+class TestReplay {
+   public:
+    TestReplay(TestFixture& fixture, TestDriver& driver);
+    ~TestReplay();
+
+    static std::vector<ReplayEvent> load(const std::string& path);
+
+    void run(const std::vector<ReplayEvent>& events);
+
+    /* Compares the transcript against `path`. When QMK_REPLAY_UPDATE is set in
+     * the environment the file is rewritten instead. */
+    void expect_transcript(const std::string& path) const;
+
+    const std::vector<std::string>& transcript() const { return m_transcript; }
+    const ReplayStats&              stats() const { return m_stats; }
+    std::string                     summary() const;
+
+    void record_decision(uint16_t latency);
+
+    static TestReplay* m_this;
+
+   private:
+    void record_report(const report_keyboard_t& report);
+    void scan_until(uint32_t time);
+
+    TestFixture&             m_fixture;
+    uint32_t                 m_start;
+    std::vector<std::string> m_transcript;
+    ReplayStats              m_stats;
+};
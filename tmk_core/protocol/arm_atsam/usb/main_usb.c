@@ -23,6 +23,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "raw_hid.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 uint8_t keyboard_protocol = 1;
 
 void main_suspend_action(void) {
@@ -115,6 +119,11 @@ void main_raw_disable(void) {
 }
 
 void main_raw_receive(uint8_t *buffer, uint8_t len) {
+#    ifdef TELEMETRY_ENABLE
+    if (telemetry_receive(buffer, len)) {
+        return;
+    }
+#    endif
     raw_hid_receive(buffer, len);
 }
 #endif
@@ -42,6 +42,7 @@
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
+#include "ring_buffer.h"
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -53,6 +54,10 @@ extern keymap_config_t keymap_config;
 #    include "joystick.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 /* ---------------------------------------------------------
  *       Global interface variables and declarations
  * ---------------------------------------------------------
@@ -387,34 +392,11 @@ static usb_driver_configs_t drivers = {
  */
 
 #define USB_EVENT_QUEUE_SIZE 16
-usbevent_t event_queue[USB_EVENT_QUEUE_SIZE];
-uint8_t    event_queue_head;
-uint8_t    event_queue_tail;
+RING_BUFFER_DECLARE(usb_event_queue, usbevent_t, USB_EVENT_QUEUE_SIZE);
 
 void usb_event_queue_init(void) {
     // Initialise the event queue
-    memset(&event_queue, 0, sizeof(event_queue));
-    event_queue_head = 0;
-    event_queue_tail = 0;
-}
-
-static inline bool usb_event_queue_enqueue(usbevent_t event) {
-    uint8_t next = (event_queue_head + 1) % USB_EVENT_QUEUE_SIZE;
-    if (next == event_queue_tail) {
-        return false;
-    }
-    event_queue[event_queue_head] = event;
-    event_queue_head              = next;
-    return true;
-}
-
-static inline bool usb_event_queue_dequeue(usbevent_t *event) {
-    if (event_queue_head == event_queue_tail) {
-        return false;
-    }
-    *event           = event_queue[event_queue_tail];
-    event_queue_tail = (event_queue_tail + 1) % USB_EVENT_QUEUE_SIZE;
-    return true;
+    usb_event_queue_clear();
 }
 
 static inline void usb_event_suspend_handler(void) {
@@ -456,6 +438,9 @@ void usb_event_queue_task(void) {
                 break;
             case USB_EVENT_RESET:
                 usb_device_state_set_reset();
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+                host_mouse_set_scroll_resolution(0);
+#endif
                 break;
             default:
                 // Nothing to do, we don't handle it.
@@ -560,12 +545,22 @@ static void    set_led_transfer_cb(USBDriver *usbp) {
         uint8_t report_id = set_report_buf[0];
         if ((report_id == REPORT_ID_KEYBOARD) || (report_id == REPORT_ID_NKRO)) {
             keyboard_led_state = set_report_buf[1];
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+        } else if (report_id == REPORT_ID_MOUSE) {
+            host_mouse_set_scroll_resolution(set_report_buf[1]);
+#endif
         }
     } else {
         keyboard_led_state = set_report_buf[0];
     }
 }
 
+#if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP) && defined(MOUSE_SCROLL_HIRES_ENABLE)
+static void set_mouse_transfer_cb(USBDriver *usbp) {
+    host_mouse_set_scroll_resolution(set_report_buf[0]);
+}
+#endif
+
 /* Callback for SETUP request on the endpoint 0 (control) */
 static bool usb_request_hook_cb(USBDriver *usbp) {
     const USBDescriptor *dp;
@@ -628,6 +623,13 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
                                 usbSetupTransfer(usbp, set_report_buf, sizeof(set_report_buf), set_led_transfer_cb);
                                 return TRUE;
                                 break;
+
+#if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP) && defined(MOUSE_SCROLL_HIRES_ENABLE)
+                            case MOUSE_INTERFACE:
+                                usbSetupTransfer(usbp, set_report_buf, sizeof(set_report_buf), set_mouse_transfer_cb);
+                                return TRUE;
+                                break;
+#endif
                         }
                         break;
 
@@ -1092,6 +1094,14 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     chnWrite(&drivers.raw_driver.driver, data, length);
 }
 
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    if (length != RAW_EPSIZE) {
+        return false;
+    }
+    // a packet fills a whole queue buffer, so a zero timeout writes all of it or nothing
+    return chnWriteTimeout(&drivers.raw_driver.driver, data, length, TIME_IMMEDIATE) == length;
+}
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
@@ -1104,6 +1114,11 @@ void raw_hid_task(void) {
     do {
         size_t size = chnReadTimeout(&drivers.raw_driver.driver, buffer, sizeof(buffer), TIME_IMMEDIATE);
         if (size > 0) {
+#    ifdef TELEMETRY_ENABLE
+            if (telemetry_receive(buffer, size)) {
+                continue;
+            }
+#    endif
             raw_hid_receive(buffer, size);
         }
     } while (size > 0);
@@ -89,14 +89,107 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
 }
 
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+static uint8_t mouse_scroll_resolution = 0;
+/* Counts the times the host set the resolution, so that carries notice even if it set the same one again */
+static uint8_t mouse_scroll_generation = 0;
+/* Carry of the sources that do not keep their own, such as PS/2 mice */
+static mouse_scroll_carry_t host_mouse_scroll_carry = {};
+
+/* Units collected before the host last set the resolution may be wrongly scaled, so they are dropped */
+static void host_mouse_scroll_sync(mouse_scroll_carry_t *carry) {
+    if (carry->generation != mouse_scroll_generation) {
+        carry->v          = 0;
+        carry->h          = 0;
+        carry->generation = mouse_scroll_generation;
+    }
+}
+
+static void host_mouse_scroll_add(int16_t *carry, int32_t units) {
+    int32_t total = *carry + units;
+    *carry        = total > INT16_MAX ? INT16_MAX : (total < INT16_MIN ? INT16_MIN : total);
+}
+
+static int8_t host_mouse_scroll_take(int16_t *carry) {
+    int8_t units = *carry > 127 ? 127 : (*carry < -127 ? -127 : *carry);
+    *carry -= units;
+    return units;
+}
+#endif
+
+/** \brief Sends a mouse report with the wheel in detents
+ *
+ * With MOUSE_SCROLL_HIRES_ENABLE, the wheel is scaled to the resolution the host enabled, and what does not fit in
+ * the report is sent with the following ones of the sources that use this function. Sources that keep their own
+ * carry use host_mouse_send_detents() or host_mouse_send_hires().
+ */
 void host_mouse_send(report_mouse_t *report) {
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    host_mouse_send_detents(report, &host_mouse_scroll_carry);
+}
+
+/** \brief Sends a mouse report with the wheel in detents, keeping what does not fit in carry
+ */
+void host_mouse_send_detents(report_mouse_t *report, mouse_scroll_carry_t *carry) {
+    report_mouse_t scaled = *report;
+
+    host_mouse_scroll_sync(carry);
+    host_mouse_scroll_add(&carry->v, (int32_t)report->v * host_mouse_scroll_multiplier(false));
+    host_mouse_scroll_add(&carry->h, (int32_t)report->h * host_mouse_scroll_multiplier(true));
+    scaled.v = 0;
+    scaled.h = 0;
+    host_mouse_send_hires(&scaled, carry);
+}
+
+/** \brief Sends a mouse report with the wheel already in the units given by host_mouse_scroll_multiplier()
+ *
+ * What does not fit in the report is kept in carry, which belongs to the source of the report.
+ */
+void host_mouse_send_hires(report_mouse_t *report, mouse_scroll_carry_t *carry) {
+    host_mouse_scroll_sync(carry);
+    host_mouse_scroll_add(&carry->v, report->v);
+    host_mouse_scroll_add(&carry->h, report->h);
+    report->v = host_mouse_scroll_take(&carry->v);
+    report->h = host_mouse_scroll_take(&carry->h);
+#endif
     if (!driver) return;
 #ifdef MOUSE_SHARED_EP
     report->report_id = REPORT_ID_MOUSE;
+#endif
+#ifdef MOUSE_EXTENDED_REPORT
+    // clip and copy to Boot protocol XY
+    report->boot_x = (report->x > 127) ? 127 : ((report->x < -127) ? -127 : report->x);
+    report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
     (*driver->send_mouse)(report);
 }
 
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+/** \brief Stores the Resolution Multiplier feature report sent by the host
+ *
+ * Hosts that do not know about high resolution scrolling never send it, so the wheel stays in detents for them.
+ */
+void host_mouse_set_scroll_resolution(uint8_t resolution) {
+    mouse_scroll_resolution = resolution;
+    mouse_scroll_generation++;
+}
+
+/** \brief Whether wheel motion kept in carry is still waiting to be sent
+ */
+bool host_mouse_scroll_pending(mouse_scroll_carry_t *carry) {
+    host_mouse_scroll_sync(carry);
+    return carry->v || carry->h;
+}
+
+/** \brief Number of wheel units the host expects per detent
+ *
+ * \return MOUSE_SCROLL_MULTIPLIER if the host enabled high resolution scrolling for the axis, 1 otherwise
+ */
+uint8_t host_mouse_scroll_multiplier(bool horizontal) {
+    return (mouse_scroll_resolution & (horizontal ? MOUSE_SCROLL_HIRES_H : MOUSE_SCROLL_HIRES_V)) ? MOUSE_SCROLL_MULTIPLIER : 1;
+}
+#endif
+
 void host_system_send(uint16_t report) {
     if (report == last_system_report) return;
     last_system_report = report;
@@ -49,6 +49,21 @@ void    host_system_send(uint16_t data);
 void    host_consumer_send(uint16_t data);
 void    host_programmable_button_send(uint32_t data);
 
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+/* Wheel units of one source of mouse reports that did not fit in its previous reports */
+typedef struct {
+    int16_t v;
+    int16_t h;
+    uint8_t generation; // of the host resolution the units were collected at
+} mouse_scroll_carry_t;
+
+void    host_mouse_send_detents(report_mouse_t *report, mouse_scroll_carry_t *carry);
+void    host_mouse_send_hires(report_mouse_t *report, mouse_scroll_carry_t *carry);
+void    host_mouse_set_scroll_resolution(uint8_t resolution);
+uint8_t host_mouse_scroll_multiplier(bool horizontal);
+bool    host_mouse_scroll_pending(mouse_scroll_carry_t *carry);
+#endif
+
 uint16_t host_last_system_report(void);
 uint16_t host_last_consumer_report(void);
 uint32_t host_last_programmable_button_report(void);
@@ -86,6 +86,10 @@ extern keymap_config_t keymap_config;
 #    include "raw_hid.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "joystick.h"
 #endif
@@ -135,18 +139,22 @@ USB_ClassInfo_CDC_Device_t cdc_device = {
 
 #ifdef RAW_ENABLE
 
-/** \brief Raw HID Send
+/** \brief Raw HID Try Send
  *
- * FIXME: Needs doc
+ * Sends the packet if the host has read the previous one, without waiting.
+ *
+ * \return true if the packet was sent
  */
-void raw_hid_send(uint8_t *data, uint8_t length) {
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    bool sent = false;
+
     // TODO: implement variable size packet
     if (length != RAW_EPSIZE) {
-        return;
+        return false;
     }
 
     if (USB_DeviceState != DEVICE_STATE_Configured) {
-        return;
+        return false;
     }
 
     // TODO: decide if we allow calls to raw_hid_send() in the middle
@@ -161,9 +169,19 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
         Endpoint_Write_Stream_LE(data, RAW_EPSIZE, NULL);
         // Finalize the stream transfer to send the last packet
         Endpoint_ClearIN();
+        sent = true;
     }
 
     Endpoint_SelectEndpoint(ep);
+    return sent;
+}
+
+/** \brief Raw HID Send
+ *
+ * FIXME: Needs doc
+ */
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    raw_hid_try_send(data, length);
 }
 
 /** \brief Raw HID Receive
@@ -203,6 +221,11 @@ static void raw_hid_task(void) {
         Endpoint_ClearOUT();
 
         if (data_read) {
+#    ifdef TELEMETRY_ENABLE
+            if (telemetry_receive(data, sizeof(data))) {
+                return;
+            }
+#    endif
             raw_hid_receive(data, sizeof(data));
         }
     }
@@ -380,6 +403,9 @@ void EVENT_USB_Device_Disconnect(void) {
 void EVENT_USB_Device_Reset(void) {
     print("[R]");
     usb_device_state_set_reset();
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+    host_mouse_set_scroll_resolution(0);
+#endif
 }
 
 /** \brief Event USB Device Connect
@@ -566,6 +592,10 @@ void EVENT_USB_Device_ControlRequest(void) {
 
                             if (report_id == REPORT_ID_KEYBOARD || report_id == REPORT_ID_NKRO) {
                                 keyboard_led_state = Endpoint_Read_8();
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+                            } else if (report_id == REPORT_ID_MOUSE) {
+                                host_mouse_set_scroll_resolution(Endpoint_Read_8());
+#endif
                             }
                         } else {
                             keyboard_led_state = Endpoint_Read_8();
@@ -574,6 +604,20 @@ void EVENT_USB_Device_ControlRequest(void) {
                         Endpoint_ClearOUT();
                         Endpoint_ClearStatusStage();
                         break;
+#if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP) && defined(MOUSE_SCROLL_HIRES_ENABLE)
+                    case MOUSE_INTERFACE:
+                        Endpoint_ClearSETUP();
+
+                        while (!(Endpoint_IsOUTReceived())) {
+                            if (USB_DeviceState == DEVICE_STATE_Unattached) return;
+                        }
+
+                        host_mouse_set_scroll_resolution(Endpoint_Read_8());
+
+                        Endpoint_ClearOUT();
+                        Endpoint_ClearStatusStage();
+                        break;
+#endif
                 }
             }
 
@@ -700,7 +744,11 @@ static void send_mouse(report_mouse_t *report) {
     if (where_to_send() == OUTPUT_BLUETOOTH) {
 #        ifdef BLUETOOTH_BLUEFRUIT_LE
         // FIXME: mouse buttons
+#            ifdef MOUSE_EXTENDED_REPORT
+        bluefruit_le_send_mouse_move(report->boot_x, report->boot_y, report->v, report->h, report->buttons);
+#            else
         bluefruit_le_send_mouse_move(report->x, report->y, report->v, report->h, report->buttons);
+#            endif
 #        elif BLUETOOTH_RN42
         rn42_send_mouse(report);
 #        endif
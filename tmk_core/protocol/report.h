@@ -201,15 +201,47 @@ typedef struct {
     uint32_t usage;
 } __attribute__((packed)) report_programmable_button_t;
 
+#ifdef MOUSE_EXTENDED_REPORT
+#    if defined(PROTOCOL_VUSB) || defined(PROTOCOL_ARM_ATSAM)
+#        error "MOUSE_EXTENDED_REPORT is not supported with this protocol"
+#    endif
+#    define MOUSE_REPORT_XY_MIN -32767
+#    define MOUSE_REPORT_XY_MAX 32767
+typedef int16_t mouse_xy_report_t;
+#else
+#    define MOUSE_REPORT_XY_MIN -127
+#    define MOUSE_REPORT_XY_MAX 127
+typedef int8_t mouse_xy_report_t;
+#endif
+
+#ifdef MOUSE_SCROLL_HIRES_ENABLE
+#    if defined(PROTOCOL_VUSB) || defined(PROTOCOL_ARM_ATSAM)
+#        error "MOUSE_SCROLL_HIRES_ENABLE is not supported with this protocol"
+#    endif
+#    ifndef MOUSE_SCROLL_MULTIPLIER
+#        define MOUSE_SCROLL_MULTIPLIER 120
+#    elif MOUSE_SCROLL_MULTIPLIER < 2 || MOUSE_SCROLL_MULTIPLIER > 127
+#        error "MOUSE_SCROLL_MULTIPLIER must be between 2 and 127"
+#    endif
+/* Resolution Multiplier feature report, set by hosts that support high resolution scrolling */
+#    define MOUSE_SCROLL_HIRES_V (1 << 0)
+#    define MOUSE_SCROLL_HIRES_H (1 << 2)
+#endif
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
 #endif
     uint8_t buttons;
-    int8_t  x;
-    int8_t  y;
-    int8_t  v;
-    int8_t  h;
+#ifdef MOUSE_EXTENDED_REPORT
+    /* Clipped copy of x and y for hosts using the boot protocol, filled in by host_mouse_send() */
+    int8_t boot_x;
+    int8_t boot_y;
+#endif
+    mouse_xy_report_t x;
+    mouse_xy_report_t y;
+    int8_t            v;
+    int8_t            h;
 } __attribute__((packed)) report_mouse_t;
 
 typedef struct {
@@ -39,6 +39,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include "serial.h"
+#include "ring_buffer.h"
 
 #ifndef SERIAL_UART_BAUD
 #    define SERIAL_UART_BAUD 9600
@@ -61,7 +62,7 @@ POSSIBILITY OF SUCH DAMAGE.
 //   Empty:           RBUF_SPACE == RBUF_SIZE(head==tail)
 //   Last 1 space:    RBUF_SPACE == 2
 //   Full:            RBUF_SPACE == 1(last cell of rbuf be never used.)
-#    define RBUF_SPACE() (rbuf_head < rbuf_tail ? (rbuf_tail - rbuf_head) : (RBUF_SIZE - rbuf_head + rbuf_tail))
+#    define RBUF_SPACE() (RBUF_SIZE - rbuf_count())
 // allow to send
 #    define rbuf_check_rts_lo()                         \
         do {                                            \
@@ -88,30 +89,24 @@ void serial_init(void) {
 
 // RX ring buffer
 #define RBUF_SIZE 256
-static uint8_t rbuf[RBUF_SIZE];
-static uint8_t rbuf_head = 0;
-static uint8_t rbuf_tail = 0;
+RING_BUFFER_DECLARE(rbuf, uint8_t, RBUF_SIZE);
 
 uint8_t serial_recv(void) {
     uint8_t data = 0;
-    if (rbuf_head == rbuf_tail) {
+    if (!rbuf_dequeue(&data)) {
         return 0;
     }
 
-    data      = rbuf[rbuf_tail];
-    rbuf_tail = (rbuf_tail + 1) % RBUF_SIZE;
     rbuf_check_rts_lo();
     return data;
 }
 
 int16_t serial_recv2(void) {
     uint8_t data = 0;
-    if (rbuf_head == rbuf_tail) {
+    if (!rbuf_dequeue(&data)) {
         return -1;
     }
 
-    data      = rbuf[rbuf_tail];
-    rbuf_tail = (rbuf_tail + 1) % RBUF_SIZE;
     rbuf_check_rts_lo();
     return data;
 }
@@ -124,10 +119,6 @@ void serial_send(uint8_t data) {
 
 // USART RX complete interrupt
 ISR(SERIAL_UART_RXD_VECT) {
-    uint8_t next = (rbuf_head + 1) % RBUF_SIZE;
-    if (next != rbuf_tail) {
-        rbuf[rbuf_head] = SERIAL_UART_DATA;
-        rbuf_head       = next;
-    }
+    rbuf_enqueue(SERIAL_UART_DATA);
     rbuf_check_rts_hi();
 }
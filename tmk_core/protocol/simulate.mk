@@ -0,0 +1,10 @@
+SIMULATE_DIR = protocol/simulate
+
+SRC += $(SIMULATE_DIR)/simulate.c
+
+# Search Path
+VPATH += $(TMK_PATH)/$(SIMULATE_DIR)
+
+POST_CONFIG_H += $(TMK_PATH)/$(SIMULATE_DIR)/simulate_config.h
+
+OPT_DEFS += -DPROTOCOL_SIMULATE
@@ -0,0 +1,265 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Host runtime for `SIMULATE = yes` builds.
+ *
+ * Stands in for the USB stack and the keyboard's matrix, so the keymap runs
+ * through the real scan, debounce, action and report pipeline as a host
+ * executable:
+ *
+ *     simulate [TRACE [OUTPUT]]
+ *
+ * The trace holds one key event per line, `<time ms> <col> <row> <d|u>`, with
+ * `#` starting a comment. This is the same format the test replay harness
+ * reads. Times are relative to the end of keyboard_init() and must not
+ * decrease. Time is virtual: the firmware is scanned once per millisecond, as
+ * fast as the host allows, so timers such as one-shot, tap dance, leader and
+ * deferred_exec() expire at the same point of the trace as on a keyboard.
+ *
+ * With SIMULATE_SKIP_IDLE, a gap with no keys held is cut short after
+ * SIMULATE_IDLE_SCANS milliseconds by advancing the timer instead. This is
+ * only correct if nothing in the keymap waits that long without a key held.
+ *
+ * Every report is written to OUTPUT with the virtual time it was sent at, one
+ * per line, and a throughput summary goes to stderr. Either path may be `-`,
+ * which is also the default, for stdin or stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "action.h"
+#include "action_tapping.h"
+#include "host.h"
+#include "keyboard.h"
+#include "keycode_config.h"
+#include "matrix.h"
+#include "timer.h"
+
+/* Milliseconds scanned after the last event, so that pending timers expire,
+ * and with SIMULATE_SKIP_IDLE before the rest of an idle gap is skipped. */
+#ifndef SIMULATE_IDLE_SCANS
+#    define SIMULATE_IDLE_SCANS (TAPPING_TERM * 10)
+#endif
+
+void platform_setup(void);
+void protocol_init(void);
+void protocol_task(void);
+void advance_time(uint32_t ms);
+#ifdef DEFERRED_EXEC_ENABLE
+void deferred_exec_task(void);
+#endif
+
+uint8_t keyboard_idle     = 0;
+uint8_t keyboard_protocol = 1;
+
+static FILE        *output;
+static uint32_t     start;
+static matrix_row_t simulated_matrix[MATRIX_ROWS];
+static unsigned     keys_held;
+
+static struct {
+    unsigned long events;
+    unsigned long reports;
+    unsigned long scans;
+} stats;
+
+static void report_start(const char *type) {
+    fprintf(output, "%lu %s", (unsigned long)(timer_read32() - start), type);
+    stats.reports++;
+}
+
+static uint8_t keyboard_leds(void) {
+    return 0;
+}
+
+static void send_keyboard(report_keyboard_t *report) {
+    report_start("keyboard");
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        fprintf(output, " %02X", report->nkro.mods);
+        for (uint16_t i = 0; i < KEYBOARD_REPORT_BITS * 8; i++) {
+            if (report->nkro.bits[i / 8] & (1 << (i % 8))) {
+                fprintf(output, " %02X", i);
+            }
+        }
+        fputc('\n', output);
+        return;
+    }
+#endif
+    fprintf(output, " %02X", report->mods);
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i]) {
+            fprintf(output, " %02X", report->keys[i]);
+        }
+    }
+    fputc('\n', output);
+}
+
+static void send_mouse(report_mouse_t *report) {
+    report_start("mouse");
+    fprintf(output, " %02X %d %d %d %d\n", report->buttons, report->x, report->y, report->v, report->h);
+}
+
+static void send_system(uint16_t data) {
+    report_start("system");
+    fprintf(output, " %04X\n", data);
+}
+
+static void send_consumer(uint16_t data) {
+    report_start("consumer");
+    fprintf(output, " %04X\n", data);
+}
+
+static void send_programmable_button(uint32_t data) {
+    report_start("programmable_button");
+    fprintf(output, " %08lX\n", (unsigned long)data);
+}
+
+static host_driver_t simulate_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button};
+
+void protocol_setup(void) {}
+
+void protocol_pre_init(void) {
+    host_set_driver(&simulate_driver);
+}
+
+void protocol_post_init(void) {}
+
+void protocol_pre_task(void) {}
+
+void protocol_post_task(void) {}
+
+void matrix_init_custom(void) {
+    memset(simulated_matrix, 0, sizeof(simulated_matrix));
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    bool changed = memcmp(current_matrix, simulated_matrix, sizeof(simulated_matrix)) != 0;
+
+    if (changed) {
+        memcpy(current_matrix, simulated_matrix, sizeof(simulated_matrix));
+    }
+    return changed;
+}
+
+/* One pass of the main loop in quantum/main.c, followed by a millisecond. */
+static void scan(void) {
+    protocol_task();
+#ifdef DEFERRED_EXEC_ENABLE
+    deferred_exec_task();
+#endif
+    housekeeping_task();
+    advance_time(1);
+    stats.scans++;
+}
+
+static void scan_until(uint32_t time) {
+    uint32_t target = start + time;
+
+#ifdef SIMULATE_SKIP_IDLE
+    if (keys_held == 0 && (int32_t)(target - timer_read32()) > SIMULATE_IDLE_SCANS) {
+        for (uint32_t i = 0; i < SIMULATE_IDLE_SCANS; i++) {
+            scan();
+        }
+        advance_time(target - timer_read32());
+    }
+#endif
+
+    while ((int32_t)(target - timer_read32()) > 0) {
+        scan();
+    }
+}
+
+static void set_key(uint8_t col, uint8_t row, bool pressed) {
+    matrix_row_t bit = MATRIX_ROW_SHIFTER << col;
+
+    if (pressed && !(simulated_matrix[row] & bit)) {
+        simulated_matrix[row] |= bit;
+        keys_held++;
+    } else if (!pressed && (simulated_matrix[row] & bit)) {
+        simulated_matrix[row] &= ~bit;
+        keys_held--;
+    }
+}
+
+static FILE *open_file(const char *path, const char *mode, FILE *standard) {
+    if (strcmp(path, "-") == 0) {
+        return standard;
+    }
+
+    FILE *file = fopen(path, mode);
+    if (!file) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 3) {
+        fprintf(stderr, "usage: %s [TRACE [OUTPUT]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *trace_path = argc > 1 ? argv[1] : "-";
+    FILE       *trace      = open_file(trace_path, "r", stdin);
+    output                 = open_file(argc > 2 ? argv[2] : "-", "w", stdout);
+
+    platform_setup();
+    protocol_setup();
+    keyboard_setup();
+    protocol_init();
+    start = timer_read32();
+
+    clock_t       started = clock();
+    char          line[256];
+    unsigned      line_number = 0;
+    unsigned long last        = 0;
+    while (fgets(line, sizeof(line), trace)) {
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+
+        unsigned long time;
+        unsigned      col, row;
+        char          state;
+        int           fields = sscanf(line, "%lu %u %u %c", &time, &col, &row, &state);
+        if (fields == EOF) {
+            continue;
+        }
+        if (fields != 4 || col >= MATRIX_COLS || row >= MATRIX_ROWS || (state != 'd' && state != 'u') || time < last) {
+            fprintf(stderr, "%s:%u: malformed event '%s'\n", trace_path, line_number, line);
+            return EXIT_FAILURE;
+        }
+        last = time;
+
+        scan_until(time);
+        set_key(col, row, state == 'd');
+        scan();
+        stats.events++;
+    }
+
+    /* Let every pending decision resolve before the output is closed. */
+    scan_until(timer_read32() - start + SIMULATE_IDLE_SCANS);
+
+    double wall_seconds = (double)(clock() - started) / CLOCKS_PER_SEC;
+    fprintf(stderr, "%lu events, %lu reports, %lu scans over %lu ms of virtual time in %.3f s (%.0f scans/s)\n", stats.events, stats.reports, stats.scans, (unsigned long)(timer_read32() - start), wall_seconds, wall_seconds > 0 ? stats.scans / wall_seconds : 0);
+
+    fflush(output);
+    return EXIT_SUCCESS;
+}
@@ -35,8 +35,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "raw_hid.h"
 #endif
 
+#ifdef TELEMETRY_ENABLE
+#    include "telemetry.h"
+#endif
+
 #if defined(CONSOLE_ENABLE)
-#    define RBUF_SIZE 128
 #    include "ring_buffer.h"
 #endif
 
@@ -150,6 +153,15 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     usbSetInterrupt4(0, 0);
 }
 
+bool raw_hid_try_send(uint8_t *data, uint8_t length) {
+    // the rest of the packet follows the first chunk while the host keeps polling
+    if (length != RAW_BUFFER_SIZE || !usbInterruptIsReady4()) {
+        return false;
+    }
+    raw_hid_send(data, length);
+    return true;
+}
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
@@ -158,7 +170,13 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
 
 void raw_hid_task(void) {
     if (raw_output_received_bytes == RAW_BUFFER_SIZE) {
-        raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+        bool handled = false;
+#    ifdef TELEMETRY_ENABLE
+        handled = telemetry_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+#    endif
+        if (!handled) {
+            raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+        }
         raw_output_received_bytes = 0;
     }
 }
@@ -171,6 +189,8 @@ void raw_hid_task(void) {
 #    define CONSOLE_BUFFER_SIZE 32
 #    define CONSOLE_EPSIZE 8
 
+RING_BUFFER_DECLARE(rbuf, uint8_t, 128);
+
 int8_t sendchar(uint8_t c) {
     rbuf_enqueue(c);
     return 0;
@@ -201,8 +221,9 @@ void console_task(void) {
     // Send in chunks of 8 padded to 32
     char    send_buf[CONSOLE_BUFFER_SIZE] = {0};
     uint8_t send_buf_count                = 0;
-    while (rbuf_has_data() && send_buf_count < CONSOLE_EPSIZE) {
-        send_buf[send_buf_count++] = rbuf_dequeue();
+    uint8_t c;
+    while (send_buf_count < CONSOLE_EPSIZE && rbuf_dequeue(&c)) {
+        send_buf[send_buf_count++] = c;
     }
 
     char *temp = send_buf;
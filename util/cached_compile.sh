@@ -0,0 +1,99 @@
+#!/usr/bin/env bash
+#
+# Compiles a C file through a content addressed object cache, used by the
+# build for OBJECT_CACHE = yes:
+#
+#     util/cached_compile.sh CACHE_DIR CC [FLAGS...] -c SOURCE -o OBJECT
+#
+# The cache key is the compiler version, the flags that affect code
+# generation and the preprocessed source without line markers. Include paths
+# and defines only change the preprocessed source, so keyboards whose
+# configuration yields the same source share the object, wherever their
+# headers live. The compiler output is kept with the object and replayed on
+# a hit, so warnings still show up in the build log.
+
+set -o pipefail
+
+cache_dir=$1
+shift
+
+if command -v sha256sum > /dev/null; then
+    hash_cmd=(sha256sum)
+else
+    hash_cmd=(shasum -a 256)
+fi
+
+object=
+dep_file=
+preprocess=()
+key_flags=()
+while [ $# -gt 0 ]; do
+    case $1 in
+        -o)
+            object=$2
+            shift
+            ;;
+        -MF)
+            dep_file=$2
+            shift
+            ;;
+        -MMD | -MP | -c) ;;
+        -include | -imacros | -isystem | -iquote | -I | -D | -U)
+            preprocess+=("$1" "$2")
+            shift
+            ;;
+        -I* | -D* | -U* | -Wa,-adhlns=*)
+            preprocess+=("$1")
+            ;;
+        *.c)
+            preprocess+=("$1")
+            ;;
+        *)
+            preprocess+=("$1")
+            key_flags+=("$1")
+            ;;
+    esac
+    shift
+done
+
+compile() {
+    "${preprocess[@]}" -c ${dep_file:+-MMD -MP -MF "$dep_file"} -o "$object"
+}
+
+if [ -z "$object" ]; then
+    compile
+    exit
+fi
+
+mkdir -p "$cache_dir"
+temp=$(mktemp "$cache_dir/tmp.XXXXXX") || exit 1
+trap 'rm -f "$temp" "$temp.o" "$temp.log"' EXIT
+
+# Preprocessing also writes the dependency file that a hit would otherwise lack
+if ! "${preprocess[@]}" -E -P ${dep_file:+-MMD -MP -MF "$dep_file" -MT "$object"} -o "$temp" 2> /dev/null; then
+    compile
+    exit
+fi
+
+key=$({
+    "${preprocess[0]}" --version | head -n 1
+    printf '%s\n' "${key_flags[@]}"
+    cat "$temp"
+} | "${hash_cmd[@]}" | cut -d ' ' -f 1)
+cached="$cache_dir/${key:0:2}/$key"
+
+if [ -f "$cached.o" ]; then
+    cat "$cached.log" >&2
+    cp "$cached.o" "$object"
+    exit
+fi
+
+compile 2> "$temp.log"
+status=$?
+cat "$temp.log" >&2
+if [ $status -eq 0 ]; then
+    # Renaming into place keeps parallel builds from reading half written objects
+    mkdir -p "${cached%/*}"
+    cp "$object" "$temp.o" && mv -f "$temp.log" "$cached.log" && mv -f "$temp.o" "$cached.o"
+fi
+exit $status